@@ -39,35 +39,285 @@
 #include <algorithm>
 #include <random>
 #include <iomanip>
+#include <cstdint>
+#include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <map>
+#include <array>
+#include <type_traits>
+#include <cstring>
+#include <cctype>
+#include <fstream>
+#include <system_error>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#if __cplusplus >= 202002L
+#include <compare>
+#include <coroutine>
+#include <optional>
+#include <span>
+#endif
+#if __cplusplus >= 201402L
+#define BIGINT_CONSTEXPR14 constexpr
+#else
+#define BIGINT_CONSTEXPR14
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BIGINT_POSIX 1
+#endif
 
 namespace BigInt {
-    class bigint
+    /*
+     * Fixed-size pool of worker threads shared by the parallel algorithms of the library.
+     */
+    class thread_pool
     {
     public:
-        //                   LLONG_MAX = 9'223'372'036'854'775'807
-        static constexpr auto MAX_SIZE = 1000000000LL;
+        explicit thread_pool(const std::size_t threads) {
+            workers.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this] { run(); });
+            }
+        }
 
-        bigint() : vec({0}) {}
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        static thread_pool& instance() {
+            static thread_pool pool(std::max(1U, std::thread::hardware_concurrency()));
+            return pool;
+        }
+
+        std::size_t size() const {
+            return workers.size();
+        }
 
-        bigint(const std::string& s) {
-            if (!is_bigint(s)) { throw std::runtime_error("Invalid Big Integer."); }
-            if (s[0] == '-') {
-                *this = bigint(s.substr(1));
-                if (*this == 0)
-                    throw std::runtime_error("Invalid Big Integer.");
-                is_neg = true;
+        template <typename F>
+        auto submit(F&& task) -> std::future<decltype(task())> {
+            using result_type = decltype(task());
+            const auto job = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(task));
+            auto future = job->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.emplace_back([job] { (*job)(); });
             }
-            else if (s[0] == '0' && s[1] == 'x') {
-                // Hex string
-                is_neg = false;
-                vec = hex_to_vector(s);
+            ready.notify_one();
+            return future;
+        }
+
+        /**
+         * @brief Runs body(0) ... body(count - 1) on up to max_threads threads and waits for all of them.
+         *
+         * The calling thread takes part in the work, so nested calls from inside a pool task cannot deadlock.
+         * The first exception thrown by body is rethrown in the caller.
+         *
+         * @param max_threads Upper bound on the number of threads including the caller, 0 for the whole pool.
+         */
+        void parallel_for(std::size_t count, const std::function<void(std::size_t)>& body, std::size_t max_threads = 0);
+
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> queue;
+        std::mutex mutex;
+        std::condition_variable ready;
+        bool stopping{false};
+
+        void run() {
+            for (;;) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [this] { return stopping || !queue.empty(); });
+                    if (queue.empty()) return;
+                    job = std::move(queue.front());
+                    queue.pop_front();
+                }
+                job();
             }
-            else {
-                is_neg = false;
-                vec = string_to_vector(s);
+        }
+    };
+
+    inline void thread_pool::parallel_for(const std::size_t count, const std::function<void(std::size_t)>& body,
+                                          std::size_t max_threads) {
+        if (count == 0) return;
+        if (max_threads == 0 || max_threads > size() + 1) max_threads = size() + 1;
+        if (max_threads > count) max_threads = count;
+
+        struct shared_state
+        {
+            const std::function<void(std::size_t)>* body;
+            std::size_t count;
+            std::atomic<std::size_t> next{0};
+            std::atomic<std::size_t> done{0};
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr error;
+        };
+        const auto state = std::make_shared<shared_state>();
+        state->body = &body;
+        state->count = count;
+
+        // Helpers that start after every index is claimed return without touching body
+        const auto work = [state] {
+            for (;;) {
+                const std::size_t i = state->next.fetch_add(1);
+                if (i >= state->count) return;
+                try {
+                    (*state->body)(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->error) state->error = std::current_exception();
+                }
+                if (state->done.fetch_add(1) + 1 == state->count) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        if (max_threads > 1) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (std::size_t i = 1; i < max_threads; ++i) {
+                    queue.emplace_back(work);
+                }
             }
+            ready.notify_all();
+        }
+        work();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state] { return state->done.load() == state->count; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    class bigint_view;
+    class bigint_reader;
+    class mapped_bigint;
+    class bigint_array;
+
+    // Result of bigint::to_chars, following std::to_chars_result
+    struct to_chars_result
+    {
+        char* ptr;
+        std::errc ec;
+    };
+
+    /*
+     * Cooperative cancellation flag shared between a caller and the asynchronous operations it started.
+     * Copies share the flag, so cancelling any copy cancels them all.
+     */
+    class cancellation_token
+    {
+    public:
+        cancellation_token() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        void cancel() const {
+            flag->store(true);
+        }
+
+        bool is_cancelled() const {
+            return flag->load();
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> flag;
+    };
+
+    // Thrown out of an asynchronous operation whose token was cancelled before it finished
+    class operation_cancelled : public std::runtime_error
+    {
+    public:
+        operation_cancelled() : std::runtime_error("Operation cancelled.") {}
+    };
+
+    // Receives the completed fraction of an asynchronous operation, in [0, 1], on the thread running it
+    using progress_callback = std::function<void(double)>;
+
+#if __cplusplus >= 202002L
+    /*
+     * Awaitable form of an asynchronous operation: co_await submits it to the thread pool and resumes the
+     * awaiting coroutine on the worker that finished it, returning the result or rethrowing its exception.
+     */
+    template <typename T>
+    class async_operation
+    {
+    public:
+        explicit async_operation(std::function<T()> work) : work(std::move(work)) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(const std::coroutine_handle<> handle) {
+            thread_pool::instance().submit([this, handle] {
+                try {
+                    result.emplace(work());
+                }
+                catch (...) {
+                    error = std::current_exception();
+                }
+                handle.resume();
+            });
+        }
+
+        T await_resume() {
+            if (error) std::rethrow_exception(error);
+            return std::move(*result);
         }
 
+    private:
+        std::function<T()> work;
+        std::optional<T> result;
+        std::exception_ptr error;
+    };
+#endif
+
+    class bigint
+    {
+        // Built-in integers are compared without a temporary; char keeps its digit meaning through bigint(char)
+        template <typename T>
+        using if_integer = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                                   !std::is_same<T, char>::value, int>::type;
+
+    public:
+        //                   LLONG_MAX = 9'223'372'036'854'775'807
+        static constexpr auto MAX_SIZE = 1000000000LL;
+
+        bigint() : vec({0}) {}
+
+        bigint(const std::string& s) : bigint(from_chars(s.data(), s.data() + s.size())) {}
+
+#if __cplusplus >= 201703L
+        bigint(const std::string_view s) : bigint(from_chars(s.data(), s.data() + s.size())) {}
+#endif
+
         bigint(const char c) {
             if (const int temp = static_cast<unsigned char>(c); isdigit(temp)) {
                 *this = bigint(char_to_int(c));
@@ -77,7 +327,7 @@ namespace BigInt {
             }
         }
 
-        bigint(const char* n) : bigint(std::string(n)) {}
+        bigint(const char* n) : bigint(from_chars(n, n + std::strlen(n))) {}
 
         bigint(const int n) :           bigint(static_cast<long long>(n)) {}
         bigint(const unsigned int n) :  bigint(static_cast<long long>(n)) {}
@@ -115,6 +365,7 @@ namespace BigInt {
         }
 
         bigint(const bigint& n) = default;
+        bigint(bigint&& n) noexcept = default;
 
         /* If initializing from a vector that should be negative, the negative value must be set afterward.
          * bigint alpha(std::vector(...));
@@ -131,6 +382,8 @@ namespace BigInt {
             return *this;
         }
 
+        bigint& operator=(bigint&& other) noexcept = default;
+
         explicit operator int() const {
             return static_cast<int>(vec.back());
         }
@@ -140,7 +393,9 @@ namespace BigInt {
         }
 
         explicit operator std::string() const {
-            return (this->is_neg ? "-" : "") + vector_to_string(this->vec);
+            std::string result(formatted_size(*this), '\0');
+            to_chars(&result[0], &result[0] + result.size(), *this);
+            return result;
         }
 
         friend std::ostream& operator<<(std::ostream& stream, const bigint& n) {
@@ -148,6 +403,17 @@ namespace BigInt {
             return stream;
         }
 
+        // Reads decimal, "0x" hex or "0b" binary digits straight into limbs, stopping at the first non-digit
+        friend std::istream& operator>>(std::istream& stream, bigint& n) {
+            const std::istream::sentry sentry(stream);
+            if (!sentry) return stream;
+
+            stream_source source{stream.rdbuf()};
+            if (!read_number(source, n)) stream.setstate(std::ios_base::failbit);
+            if (source.peek() < 0) stream.setstate(std::ios_base::eofbit);
+            return stream;
+        }
+
         bigint operator+=(const bigint& rhs) {
             if (*this == 0 && rhs == 0) return *this;
             if (*this == 0) {
@@ -250,39 +516,122 @@ namespace BigInt {
             return *this;
         }
 
-        friend bool operator==(const bigint& l, const bigint& r) {
-            if (l.is_neg != r.is_neg) {
-                return false;
-            }
-            return l.vec == r.vec;
+        friend bool operator==(const bigint& l, const bigint& r) { return compare(l, r) == 0; }
+        friend bool operator!=(const bigint& l, const bigint& r) { return compare(l, r) != 0; }
+        friend bool operator<(const bigint& l, const bigint& r) { return compare(l, r) < 0; }
+        friend bool operator>(const bigint& l, const bigint& r) { return compare(l, r) > 0; }
+        friend bool operator<=(const bigint& l, const bigint& r) { return compare(l, r) <= 0; }
+        friend bool operator>=(const bigint& l, const bigint& r) { return compare(l, r) >= 0; }
+
+        template <typename T, if_integer<T> = 0>
+        friend bool operator==(const bigint& l, const T r) { return compare(l, r) == 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator!=(const bigint& l, const T r) { return compare(l, r) != 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator<(const bigint& l, const T r) { return compare(l, r) < 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator>(const bigint& l, const T r) { return compare(l, r) > 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator<=(const bigint& l, const T r) { return compare(l, r) <= 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator>=(const bigint& l, const T r) { return compare(l, r) >= 0; }
+
+        template <typename T, if_integer<T> = 0>
+        friend bool operator==(const T l, const bigint& r) { return compare(r, l) == 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator!=(const T l, const bigint& r) { return compare(r, l) != 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator<(const T l, const bigint& r) { return compare(r, l) > 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator>(const T l, const bigint& r) { return compare(r, l) < 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator<=(const T l, const bigint& r) { return compare(r, l) >= 0; }
+        template <typename T, if_integer<T> = 0>
+        friend bool operator>=(const T l, const bigint& r) { return compare(r, l) <= 0; }
+
+#if __cplusplus >= 202002L
+        friend std::strong_ordering operator<=>(const bigint& l, const bigint& r) { return compare(l, r) <=> 0; }
+
+        template <typename T, if_integer<T> = 0>
+        friend std::strong_ordering operator<=>(const bigint& l, const T r) { return compare(l, r) <=> 0; }
+#endif
+
+        /**
+         * @brief Three-way comparison on sign, limb count and limbs, without copying either operand.
+         * @return A negative value, zero or a positive value as lhs is less than, equal to or greater than rhs.
+         */
+        static int compare(const bigint& lhs, const bigint& rhs) {
+            return compare_spans(span_of(lhs), span_of(rhs));
+        }
+
+        template <typename T, if_integer<T> = 0>
+        static int compare(const bigint& lhs, const T rhs) {
+            const bool negative = std::is_signed<T>::value && rhs < T{};
+            // Negating in unsigned arithmetic also gives the magnitude of the most negative value
+            const auto value = static_cast<unsigned long long>(rhs);
+            return compare_integer(lhs, negative, negative ? 0ULL - value : value);
         }
 
-        friend bool operator!=(const bigint& l, const bigint& r) {
-            return !(l == r);
+        explicit operator bool() const {
+            return !(vec.size() == 1 && vec.front() == 0);
         }
 
-        friend bool operator<(const bigint& lhs, const bigint& rhs) {
-            return less_than(lhs, rhs);
+        bigint& operator<<=(std::size_t shift);
+
+        bigint operator<<(const std::size_t shift) const {
+            bigint result = *this;
+            result <<= shift;
+            return result;
         }
 
-        friend bool operator>(const bigint& l, const bigint& r) {
-            return r < l;
+        bigint& operator>>=(std::size_t shift);
+
+        bigint operator>>(const std::size_t shift) const {
+            bigint result = *this;
+            result >>= shift;
+            return result;
         }
 
-        friend bool operator<=(const bigint& l, const bigint& r) {
-            return r >= l;
+        bigint& operator&=(const bigint& rhs) {
+            *this = bitwise(*this, rhs, std::bit_and<std::uint32_t>());
+            return *this;
         }
 
-        friend bool operator>=(const bigint& l, const bigint& r) {
-            return !(l < r);
+        bigint operator&(const bigint& rhs) const {
+            return bitwise(*this, rhs, std::bit_and<std::uint32_t>());
         }
 
-        explicit operator bool() const {
-            return !(vec.size() == 1 && vec.front() == 0);
+        bigint& operator|=(const bigint& rhs) {
+            *this = bitwise(*this, rhs, std::bit_or<std::uint32_t>());
+            return *this;
+        }
+
+        bigint operator|(const bigint& rhs) const {
+            return bitwise(*this, rhs, std::bit_or<std::uint32_t>());
+        }
+
+        bigint& operator^=(const bigint& rhs) {
+            *this = bitwise(*this, rhs, std::bit_xor<std::uint32_t>());
+            return *this;
+        }
+
+        bigint operator^(const bigint& rhs) const {
+            return bitwise(*this, rhs, std::bit_xor<std::uint32_t>());
+        }
+
+        // Two's complement semantics: ~x == -x - 1
+        bigint operator~() const {
+            return -*this - 1;
         }
 
         friend std::hash<bigint>;
 
+        friend class bigint_view;
+
+        friend class bigint_reader;
+
+        friend class bigint_array;
+
         static bigint pow(const bigint& base, const bigint& exponent) {
             if (base == 0) return 0;
             if (base == 1) return 1;
@@ -290,19 +639,30 @@ namespace BigInt {
             if (exponent == 0) return 1;
             if (exponent == 1) return base;
             if (base == 10) return pow10(exponent);
-
-            const bigint tmp = pow(base, exponent / 2);
-            if (exponent % 2 == 0) { return tmp * tmp; }
-            return base * tmp * tmp;
+            if (base.vec.size() == 1) return pow_small(base, exponent);
+
+            // Left-to-right square and multiply, one stage per exponent bit
+            const auto bits = to_words(exponent.vec);
+            std::size_t length = (bits.size() - 1) * 32;
+            for (std::uint32_t top = bits.back(); top != 0; top >>= 1) ++length;
+            bigint result = base;
+            for (std::size_t k = length - 1; k-- > 0;) {
+                report_progress(async_stage::power, static_cast<double>(length - 1 - k) / length);
+                result = result * result;
+                if ((bits[k / 32] >> (k % 32)) & 1) result = result * base;
+            }
+            return result;
         }
 
         static bigint pow10(const bigint& exponent) {
             if (exponent < 0) return 0;
             if (exponent == 0) return 1;
             if (exponent == 1) return 10;
-            std::string result(static_cast<int>(exponent) + 1, '0');
-            result[0] = '1';
-            return result;
+            const std::uint64_t zeros = to_uint64(exponent, "Exponent is too large");
+            std::vector<long long> result(static_cast<std::size_t>(zeros / 9) + 1, 0);
+            result.front() = 1;
+            for (std::uint64_t i = 0; i < zeros % 9; ++i) result.front() *= 10;
+            return bigint(std::move(result));
         }
 
         static bigint maximum(const bigint& lhs, const bigint& rhs) {
@@ -335,194 +695,1617 @@ namespace BigInt {
 
         static bigint logwithbase(const bigint&, const bigint&);
 
-        static bigint antilog2(const bigint&);
-
-        static bigint antilog10(const bigint&);
-
-        static void swap(bigint&, bigint&);
-
-        static bigint gcd(const bigint&, const bigint&);
+        // Exact floor(log_base(n)) for n > 0 and base >= 2
+        static std::size_t ilog(const bigint& n, const bigint& base);
 
-        static bigint lcm(const bigint& lhs, const bigint& rhs) {
-            return (lhs * rhs) / gcd(lhs, rhs);
-        }
+        // Number of bits in the magnitude, zero for zero
+        static std::size_t bit_length(const bigint&);
 
-        static bigint factorial(const bigint&);
+        /**
+         * @brief Writes the decimal representation of value into [first, last) without a terminator.
+         *
+         * @param threads Number of threads formatting chunks of very long values, 0 for the whole thread pool.
+         * @return Past-the-end pointer, or {last, std::errc::value_too_large} if the buffer is too small.
+         */
+        static to_chars_result to_chars(char* first, char* last, const bigint& value, std::size_t threads = 1);
 
-        static bool is_even(const bigint& input) {
-            return !(input.vec.back() & 1);
+        // Exact number of characters to_chars writes, including the sign
+        static std::size_t formatted_size(const bigint& value) {
+            return decimal_digits(value.vec.size(), value.vec.front()) + (is_negative(value) ? 1 : 0);
         }
 
-        static bool is_negative(const bigint& input) {
-            return input.is_neg;
+        // Decimal digits of a magnitude with `limbs` limbs led by `leading`, counted in std::size_t so that
+        // values past 2^31 digits keep an exact size
+        static BIGINT_CONSTEXPR14 std::size_t decimal_digits(const std::size_t limbs, long long leading) {
+            std::size_t digits = (limbs - 1) * 9 + 1;
+            for (; leading >= 10; leading /= 10) ++digits;
+            return digits;
         }
 
-        static bool is_prime(const bigint&);
+        /**
+         * @brief Parses [first, last) as decimal, "0x" hex or "0b" binary, optionally preceded by '-'.
+         *
+         * Validation and conversion happen in one pass without temporary strings.
+         * @throws std::runtime_error if the range is not a valid big integer.
+         */
+        static bigint from_chars(const char* first, const char* last);
 
-        static int count_digits(const bigint&);
+        // Layout of machine-word arrays for import_words and export_words
+        enum class byte_order { little, big, native };
 
-        static bigint sum_of_digits(const bigint& input) {
-            bigint sum;
-            for (auto base : input.vec) {
-                for (sum = 0; base > 0; sum += base % 10, base /= 10);
-            }
-            return sum;
-        }
+        enum class word_order { least_significant_first, most_significant_first };
 
         /**
-         * @brief Generates a random positive bigint of a specified length.
+         * @brief Magnitude from count words of word_size bytes, in the style of mpz_import.
          *
-         * This method ensures the resulting bigint is valid by using a random device
-         * and engine for non-deterministic seeding.
+         * Native little-endian words in least-significant-first order are copied straight in.
+         */
+        static bigint import_words(const void* data, std::size_t count, std::size_t word_size,
+                                   byte_order endian = byte_order::native,
+                                   word_order order = word_order::least_significant_first);
+
+        /**
+         * @brief Writes the magnitude into data as export_size(value, word_size) words, in the style of mpz_export.
          *
-         * @param length The number of digits the generated bigint should have.
-         * @return A bigint object representing the randomly generated number.
+         * @return Number of words written, zero for zero.
+         * @throws std::length_error if capacity is below export_size(value, word_size).
          */
-        static bigint random(size_t length);
+        static std::size_t export_words(const bigint& value, void* data, std::size_t capacity, std::size_t word_size,
+                                        byte_order endian = byte_order::native,
+                                        word_order order = word_order::least_significant_first);
+
+        static std::size_t export_size(const bigint& value, std::size_t word_size);
+
+        /*
+         * Binary encoding, version 1. The first byte holds the version in its high nibble, the sign in bit 0
+         * and the layout in bit 1:
+         *   compact: tag, magnitude as a LEB128 varint, used for values below 10^18
+         *   limbs:   tag, limb count as a LEB128 varint, then each base 10^9 limb, most significant first,
+         *            as a 4-byte little-endian word
+         */
+        static constexpr std::uint8_t SERIAL_VERSION = 1;
 
-    private:
-        bool is_neg{false};
-        std::vector<long long> vec;
+        // Appends the encoding of value to out
+        static void serialize(const bigint& value, std::vector<std::uint8_t>& out);
 
-        // Function Definitions for Internal Uses
-        static bigint trim(bigint input) {
-            while (input.vec.size() > 1 && input.vec.front() == 0) {
-                input.vec.erase(input.vec.begin());
-            }
-            if (input.vec.empty()) {
-                input.vec.push_back(0);
-                input.is_neg = false;
-            }
-            return input;
-        }
+        static std::size_t serialized_size(const bigint& value);
 
-        static std::vector<long long> string_to_vector(std::string input);
-        static std::vector<long long> hex_to_vector(std::string input);
+        // Decodes one value at first and advances first past it, throws std::runtime_error on malformed input
+        static bigint deserialize(const std::uint8_t*& first, const std::uint8_t* last);
 
-        static std::string vector_to_string(const std::vector<long long>& input);
+        // Writes the binary encoding of value to path, streaming the limbs without an intermediate buffer
+        static void save_file(const bigint& value, const std::string& path);
 
-        static bigint add(const bigint&, const bigint&);
+        // Maps a file written by save_file read-only; limbs are paged in on demand (POSIX, read into memory elsewhere)
+        static mapped_bigint map_file(const std::string& path);
 
-        static bigint subtract(const bigint&, const bigint&);
+        /**
+         * @brief Streaming arithmetic on serialized values, for operands too large to hold in memory.
+         *
+         * Operands are read limb by limb through their views, typically mapped_bigint::view(), and the result
+         * is written to path in the save_file format through a fixed-size chunk, so memory use does not grow
+         * with the operands. path must not be the file behind one of the operands.
+         * Sums, differences and products are produced least significant limb first: a first pass over the
+         * operands finds the length of the result and a second one writes it.
+         */
+        static void add_to_file(const bigint_view& lhs, const bigint_view& rhs, const std::string& path);
 
-        static bigint multiply(const bigint&, const bigint&);
+        static void subtract_to_file(const bigint_view& lhs, const bigint_view& rhs, const std::string& path);
 
-        static bigint divide(const bigint&, const bigint&);
+        // lhs * factor with |factor| < 10^9, throws std::domain_error otherwise
+        static void multiply_to_file(const bigint_view& lhs, long long factor, const std::string& path);
 
-        static bigint mod(const bigint& lhs, const bigint& rhs) {
-            if (rhs == 0) { throw std::domain_error("Attempted to modulo by zero."); }
-            if (lhs < rhs) {
-                return lhs;
-            }
-            if (lhs == rhs) {
-                return 0;
-            }
+        // Writes lhs / divisor with |divisor| < 10^9 and returns lhs % divisor, signs as for operator/ and operator%
+        static long long divide_to_file(const bigint_view& lhs, long long divisor, const std::string& path);
 
-            if (rhs == 2) {
-                return !is_even(lhs);
-            }
+        // Three-way comparison of two serialized values, reading limbs only up to the first difference
+        static int compare(const bigint_view& lhs, const bigint_view& rhs);
 
-            return lhs - ((lhs / rhs) * rhs);
-        }
+        // "0x" / "0b" prefixed lowercase strings, accepted back by the string constructor
+        static std::string to_hex(const bigint&);
 
-        static bool is_bigint(const std::string&);
+        static std::string to_binary(const bigint&);
 
+        /**
+         * @brief Digits of value in any base from 2 to 36, lowercase and without prefix.
+         *
+         * Power-of-two bases pack bits directly, other bases split the value around cached powers of the base.
+         * @throws std::domain_error if base is outside 2 .. 36.
+         */
+        static std::string to_string(const bigint& value, int base);
 
-        static int char_to_int(const char input) {
-            return input - '0';
-        }
+        // Parses an optionally negative run of digits in base 2 .. 36, case-insensitive
+        static bigint from_string(const std::string& str, int base);
 
-        static int int_to_char(const int input) {
-            return input + '0';
-        }
+        static bigint antilog2(const bigint&);
 
-        static bigint negate(const bigint& input) {
-            bigint temp = input;
-            temp.is_neg = !temp.is_neg;
-            return temp;
-        }
+        static bigint antilog10(const bigint&);
 
-        static bigint negate(bigint&& input) {
-            input.is_neg = !input.is_neg;
-            return input;
-        }
+        // Powers of small bases reused by pow, ilog and radix conversion are cached up to this many bytes
+        static void set_power_cache_limit(std::size_t bytes);
 
-        static bool less_than(const bigint& lhs, const bigint& rhs) {
-            if (is_negative(lhs) && is_negative(rhs)) {
-                return less_than(abs(rhs), abs(lhs));
-            }
+        static std::size_t power_cache_limit();
 
-            if (is_negative(lhs) || is_negative(rhs)) {
-                return is_negative(lhs);
-            }
+        static void clear_power_cache();
 
-            if (lhs.vec.size() == rhs.vec.size()) {
-                return lhs.vec < rhs.vec;
-            }
+        static void swap(bigint&, bigint&);
 
-            return lhs.vec.size() < rhs.vec.size();
-        }
-    };
+        static bigint gcd(const bigint&, const bigint&);
 
-    inline bool bigint::is_bigint(const std::string& s) {
-        if (s.empty())
-            return false;
+        /**
+         * @brief Extended Euclidean algorithm.
+         *
+         * @return (g, x, y) such that lhs * x + rhs * y == g, where g = gcd(lhs, rhs) is non-negative.
+         */
+        static std::tuple<bigint, bigint, bigint> gcdext(const bigint&, const bigint&);
 
-        // Check for leading negative sign
-        if (s[0] == '-') {
-            if (s.length() == 1) return false;
-            // Recursively validate the rest as a positive bigint
-            // Note: leading zeros check still applies to the magnitude
-            return is_bigint(s.substr(1));
-        }
+        // Inverse of value modulo a positive modulus, in [0, modulus)
+        static bigint modinv(const bigint& value, const bigint& modulus);
 
-        // Check for hex string "0x..."
-        if (s.length() > 2 && s[0] == '0' && s[1] == 'x') {
-            return s.find_first_not_of("0123456789abcdefABCDEF", 2) == std::string::npos;
+        static bigint lcm(const bigint& lhs, const bigint& rhs) {
+            if (lhs == 0 || rhs == 0) return 0;
+            // gcd divides lhs exactly, so divide before multiplying to keep the operands small
+            return abs(lhs / gcd(lhs, rhs) * rhs);
         }
 
-        // Reject leading zeros for decimal numbers
-        if (s.length() > 1 && s[0] == '0')
-            return false;
+        // Factorial, evaluated as a balanced product tree of word-sized blocks of consecutive factors
+        static bigint factorial(const bigint&);
 
-        return s.find_first_not_of("0123456789", 0) == std::string::npos;
-    }
+        // n!! = n * (n - 2) * (n - 4) * ...
+        static bigint double_factorial(const bigint&);
 
-    inline bigint bigint::add(const bigint& lhs, const bigint& rhs) {
-        bool negate_answer = false;
-        // Ensure both are positive
-        if (is_negative(lhs) && is_negative(rhs)) negate_answer = true;
-        else if (is_negative(lhs)) return subtract(rhs, abs(lhs));
-        else if (is_negative(rhs)) return subtract(lhs, abs(rhs));
+        // Product of all primes up to and including n
+        static bigint primorial(const bigint&);
 
-        // Ensure LHS is larger than RHS
-        if (lhs.vec.size() < rhs.vec.size()) return add(rhs, lhs);
+        // Fibonacci and Lucas numbers by fast doubling, one multiplication and one squaring per bit of n
+        static bigint fibonacci(const bigint& n);
 
-        // Prepare result vector with enough space (max size + 1 for potential carry)
-        std::vector<long long> result;
-        result.reserve(lhs.vec.size() + 1);
+        static bigint lucas(const bigint& n);
 
-        long long carry = 0;
-        auto it_l = lhs.vec.rbegin();
-        auto it_r = rhs.vec.rbegin();
+        // Power of a row-major 2x2 matrix by repeated squaring
+        static std::array<bigint, 4> matrix_pow(const std::array<bigint, 4>& matrix, const bigint& exponent);
 
-        while (it_l != lhs.vec.rend()) {
-            long long sum = *it_l + carry;
-            if (it_r != rhs.vec.rend()) {
-                sum += *it_r;
-                ++it_r;
-            }
+        // n-th term of a(k) = p * a(k - 1) + q * a(k - 2), starting from a(0) and a(1)
+        static bigint linear_recurrence(const bigint& p, const bigint& q, const bigint& a0, const bigint& a1, const bigint& n);
 
-            if (sum >= MAX_SIZE) {
-                sum -= MAX_SIZE;
-                carry = 1;
-            }
-            else {
-                carry = 0;
-            }
+        // Binomial coefficient n choose k, zero when k > n
+        static bigint binomial(const bigint& n, const bigint& k);
 
-            result.push_back(sum);
-            ++it_l;
+        /**
+         * @brief Product of a range of values convertible to bigint.
+         *
+         * The range is multiplied as a balanced binary tree, so operands at every level are of similar size
+         * and large products reach the Karatsuba kernel instead of repeatedly multiplying by a small factor.
+         * Levels holding enough limbs have their pairs multiplied across the thread pool.
+         *
+         * @param threads Upper bound on the threads used including the caller, 0 for the whole pool.
+         */
+        template <typename Iterator>
+        static bigint product(Iterator first, Iterator last, const std::size_t threads = 0) {
+            return product_tree(std::vector<bigint>(first, last), threads);
+        }
+
+        /**
+         * @brief Sum of a range of values convertible to bigint.
+         *
+         * Limbs are added column by column into a wide accumulator and carries are propagated once at the end,
+         * so no partial sum is ever copied. Long random-access ranges are split across the thread pool with an
+         * accumulator per chunk. Columns stay exact for up to 9 * 10^9 values.
+         *
+         * @param threads Upper bound on the threads used including the caller, 0 for the whole pool.
+         */
+        template <typename Iterator>
+        static bigint sum(Iterator first, Iterator last, const std::size_t threads = 0) {
+            return sum_range(first, last, threads, typename std::iterator_traits<Iterator>::iterator_category());
+        }
+
+        /**
+         * @brief Element-wise out[i] = a[i] + b[i] for i < count, spread over the thread pool.
+         *
+         * Results are written into the existing elements of out, reusing their limb storage, and out may alias a or b.
+         * Indices are handed out largest operands first, so neighbouring indices run the same kernel and no worker
+         * is left finishing one long product at the end.
+         *
+         * @param threads Upper bound on the threads used including the caller, 0 for the whole pool.
+         */
+        static void batch_add(const bigint* a, const bigint* b, bigint* out, std::size_t count, std::size_t threads = 0);
+
+        // Element-wise out[i] = a[i] * b[i], see batch_add
+        static void batch_mul(const bigint* a, const bigint* b, bigint* out, std::size_t count, std::size_t threads = 0);
+
+        // Element-wise out[i] = a[i] % m[i] with the sign of a[i], throws std::domain_error for a zero modulus
+        static void batch_mod(const bigint* a, const bigint* m, bigint* out, std::size_t count, std::size_t threads = 0);
+
+        // out[i] = a[i] % modulus for every i
+        static void batch_mod(const bigint* a, const bigint& modulus, bigint* out, std::size_t count, std::size_t threads = 0);
+
+        // Element-wise over two bigint_arrays of equal length; the results are written to one new arena
+        static bigint_array batch_add(const bigint_array& a, const bigint_array& b, std::size_t threads = 0);
+        static bigint_array batch_mul(const bigint_array& a, const bigint_array& b, std::size_t threads = 0);
+        static bigint_array batch_mod(const bigint_array& a, const bigint_array& m, std::size_t threads = 0);
+
+#if __cplusplus >= 202002L
+        static void batch_add(const std::span<const bigint> a, const std::span<const bigint> b, const std::span<bigint> out,
+                              const std::size_t threads = 0) {
+            check_batch(a.size(), b.size(), out.size());
+            batch_add(a.data(), b.data(), out.data(), out.size(), threads);
+        }
+
+        static void batch_mul(const std::span<const bigint> a, const std::span<const bigint> b, const std::span<bigint> out,
+                              const std::size_t threads = 0) {
+            check_batch(a.size(), b.size(), out.size());
+            batch_mul(a.data(), b.data(), out.data(), out.size(), threads);
+        }
+
+        static void batch_mod(const std::span<const bigint> a, const std::span<const bigint> m, const std::span<bigint> out,
+                              const std::size_t threads = 0) {
+            check_batch(a.size(), m.size(), out.size());
+            batch_mod(a.data(), m.data(), out.data(), out.size(), threads);
+        }
+
+        static void batch_mod(const std::span<const bigint> a, const bigint& modulus, const std::span<bigint> out,
+                              const std::size_t threads = 0) {
+            check_batch(a.size(), a.size(), out.size());
+            batch_mod(a.data(), modulus, out.data(), out.size(), threads);
+        }
+#endif
+
+        static bool is_even(const bigint& input) {
+            return !(input.vec.back() & 1);
+        }
+
+        static bool is_negative(const bigint& input) {
+            return input.is_neg;
+        }
+
+        /**
+         * @brief Probabilistic primality test.
+         *
+         * Trial division by a table of small primes, then Baillie-PSW (a strong base-2 Miller-Rabin test
+         * followed by a strong Lucas test). No composite is known to pass Baillie-PSW.
+         *
+         * @param rounds Additional Miller-Rabin rounds, using the small primes 3, 5, 7, ... as bases.
+         */
+        static bool is_prime(const bigint&, int rounds = 0);
+
+        /**
+         * @brief Prime search around n using an incremental sieve.
+         *
+         * Candidates are sieved by their residues modulo the small primes, which are updated with machine
+         * arithmetic as the window moves, so only survivors reach the Baillie-PSW test.
+         *
+         * @param threads Number of threads testing survivors concurrently, 0 for the whole thread pool.
+         */
+        static bigint next_prime(const bigint& n, std::size_t threads = 1);
+
+        // Largest prime below n, throws std::domain_error when n <= 2
+        static bigint prev_prime(const bigint& n, std::size_t threads = 1);
+
+        // Random prime of exactly the given bit length
+        static bigint random_prime(std::size_t bits, std::size_t threads = 1);
+
+        /**
+         * @brief Prime factorization of |n| as (prime, multiplicity) pairs in increasing order.
+         *
+         * Small factors are removed by trial division, medium ones by Pollard-Brent rho, and the rest by
+         * stage 1 of the elliptic curve method with increasing bounds, running several curves at once.
+         * Practical for inputs up to around 60 digits whose second largest prime factor is at most ~25 digits.
+         *
+         * @param threads Number of curves run concurrently, 0 for the whole thread pool.
+         */
+        static std::vector<std::pair<bigint, std::size_t>> factorize(const bigint& n, std::size_t threads = 0);
+
+        // Bit queries use two's complement semantics for negative values, like the bitwise operators.
+        static bool test_bit(const bigint&, std::size_t);
+
+        static bigint set_bit(const bigint&, std::size_t);
+
+        // Number of set bits in the magnitude
+        static std::size_t popcount(const bigint&);
+
+        static std::size_t trailing_zeros(const bigint&);
+
+        static int count_digits(const bigint&);
+
+        static bigint sum_of_digits(const bigint& input) {
+            bigint sum;
+            for (auto base : input.vec) {
+                for (sum = 0; base > 0; sum += base % 10, base /= 10);
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Generates a random positive bigint of a specified length.
+         *
+         * Equivalent to random_digits(length) on the per-thread engine.
+         *
+         * @param length The number of digits the generated bigint should have.
+         * @return A bigint object representing the randomly generated number.
+         */
+        static bigint random(size_t length);
+
+        /**
+         * @brief Uniform random value in [0, 2^bits).
+         *
+         * Words are drawn from engine and converted to limbs directly, without a string round-trip. The overloads
+         * without an engine use a per-thread std::mt19937_64, seeded from std::random_device or by seed_random.
+         *
+         * @param engine Any uniform random bit generator; the same seed gives the same value on a given standard library.
+         */
+        template <typename Engine>
+        static bigint random_bits(std::size_t bits, Engine& engine);
+
+        static bigint random_bits(const std::size_t bits) { return random_bits(bits, default_engine()); }
+
+        // Uniform random value with exactly the given number of decimal digits, throws std::domain_error for zero
+        template <typename Engine>
+        static bigint random_digits(std::size_t digits, Engine& engine);
+
+        static bigint random_digits(const std::size_t digits) { return random_digits(digits, default_engine()); }
+
+        // Uniform random value in [0, bound), throws std::domain_error unless bound is positive
+        template <typename Engine>
+        static bigint random_below(const bigint& bound, Engine& engine);
+
+        static bigint random_below(const bigint& bound) { return random_below(bound, default_engine()); }
+
+        // Reseeds the per-thread engine behind the overloads without an engine, for reproducible runs
+        static void seed_random(const std::uint64_t seed) { default_engine().seed(seed); }
+
+        /**
+         * @brief Runs a long operation on the thread pool and returns its result through a future.
+         *
+         * Operands are copied into the task. The token is checked between algorithm stages: Karatsuba levels,
+         * squaring steps of pow, levels of the factorial product tree and blocks of quotient limbs in division,
+         * so a cancelled operation stops within one stage and its future throws operation_cancelled.
+         * progress, when set, is called on the worker with a non-decreasing fraction ending at 1.
+         */
+        static std::future<bigint> async_multiply(bigint lhs, bigint rhs, cancellation_token token = {},
+                                                  progress_callback progress = {});
+        static std::future<bigint> async_pow(bigint base, bigint exponent, cancellation_token token = {},
+                                             progress_callback progress = {});
+        static std::future<bigint> async_factorial(bigint n, cancellation_token token = {},
+                                                   progress_callback progress = {});
+        static std::future<std::pair<bigint, bigint>> async_divmod(bigint numerator, bigint denominator,
+                                                                   cancellation_token token = {},
+                                                                   progress_callback progress = {});
+
+#if __cplusplus >= 202002L
+        // Awaitable versions of the asynchronous operations above, for use with co_await
+        static async_operation<bigint> co_multiply(bigint lhs, bigint rhs, cancellation_token token = {},
+                                                   progress_callback progress = {});
+        static async_operation<bigint> co_pow(bigint base, bigint exponent, cancellation_token token = {},
+                                              progress_callback progress = {});
+        static async_operation<bigint> co_factorial(bigint n, cancellation_token token = {},
+                                                    progress_callback progress = {});
+        static async_operation<std::pair<bigint, bigint>> co_divmod(bigint numerator, bigint denominator,
+                                                                    cancellation_token token = {},
+                                                                    progress_callback progress = {});
+#endif
+
+    private:
+        bool is_neg{false};
+        std::vector<long long> vec;
+
+        class montgomery;
+
+        // Primes below SMALL_PRIME_LIMIT, used for trial division
+        static constexpr std::uint32_t SMALL_PRIME_LIMIT = 2000;
+        static const std::vector<std::uint32_t>& small_primes();
+
+        // Remainder of the magnitude divided by a small divisor
+        static std::uint32_t mod_small(const bigint& input, std::uint32_t divisor) {
+            std::uint64_t remainder = 0;
+            for (const auto limb : input.vec) {
+                remainder = (remainder * MAX_SIZE + static_cast<std::uint64_t>(limb)) % divisor;
+            }
+            return static_cast<std::uint32_t>(remainder);
+        }
+
+        static bool strong_probable_prime(const montgomery& context, const bigint& base);
+        static bool strong_lucas_probable_prime(const montgomery& context);
+        // Baillie-PSW plus extra rounds, for inputs with no factor below SMALL_PRIME_LIMIT
+        static bool baillie_psw(const bigint& input, int rounds);
+
+        static bigint sieve_search(const bigint& start, bool upward, std::size_t threads);
+
+        static std::vector<std::uint32_t> sieve_primes(std::uint32_t limit);
+
+        // A non-trivial factor of an odd composite with no factor below SMALL_PRIME_LIMIT
+        static bigint find_factor(const bigint& n, std::size_t threads);
+
+        // Factor found by the method, or 0 on failure
+        static bigint pollard_brent(const montgomery& context, std::uint64_t c, std::size_t max_iterations);
+        static bigint ecm_curve(const montgomery& context, const std::vector<std::uint32_t>& primes,
+                                const std::vector<bool>& prime_flags, std::uint64_t sigma, std::uint32_t bound);
+
+        // Stages able to report progress; the first one reached in an operation owns its progress
+        enum class async_stage { none, power, product, division, multiply };
+
+        // Token and callback of the asynchronous operation running on this thread
+        struct async_context
+        {
+            cancellation_token token;
+            progress_callback progress;
+            async_stage owner;
+            double reported;
+            // Share of the progress held by the multiplication running now, narrowed for each sub-product
+            double low;
+            double width;
+        };
+
+        static async_context*& current_async() {
+            thread_local async_context* context = nullptr;
+            return context;
+        }
+
+        // Throws operation_cancelled if the operation running on this thread was cancelled
+        static void cancellation_point() {
+            const async_context* context = current_async();
+            if (context != nullptr && context->token.is_cancelled()) throw operation_cancelled();
+        }
+
+        static void report_progress(async_stage stage, double fraction);
+
+        // Hands sub-product index of parts its share of the current multiplication's progress, reports the start
+        // of that share and restores the enclosing one on destruction
+        class progress_slice
+        {
+        public:
+            progress_slice(std::size_t index, std::size_t parts) : context(current_async()) {
+                if (context == nullptr) return;
+                low = context->low;
+                width = context->width;
+                context->low = low + width * static_cast<double>(index) / static_cast<double>(parts);
+                context->width = width / static_cast<double>(parts);
+                report_progress(async_stage::multiply, context->low);
+            }
+
+            progress_slice(const progress_slice&) = delete;
+            progress_slice& operator=(const progress_slice&) = delete;
+
+            ~progress_slice() {
+                if (context == nullptr) return;
+                context->low = low;
+                context->width = width;
+            }
+
+        private:
+            async_context* context;
+            double low = 0;
+            double width = 0;
+        };
+
+        // Wraps work so that it runs with its own context installed, for async_* and co_*
+        template <typename T>
+        static std::function<T()> async_task(std::function<T()> work, cancellation_token token,
+                                             progress_callback progress);
+
+        static std::mt19937_64& default_engine() {
+            thread_local std::mt19937_64 engine{std::random_device{}()};
+            return engine;
+        }
+
+        // Function Definitions for Internal Uses
+        static bigint trim(bigint input) {
+            const auto first = std::find_if(input.vec.begin(), input.vec.end(), [](const long long x) { return x != 0; });
+            input.vec.erase(input.vec.begin(), first);
+            if (input.vec.empty()) {
+                input.vec.push_back(0);
+                input.is_neg = false;
+            }
+            return input;
+        }
+
+        // Big-endian limbs of a plain decimal digit run, validating as it goes
+        static std::vector<long long> decimal_to_vector(const char* first, const char* last);
+
+        // Value of eight ASCII digits if they all are digits, processed as one 64-bit word
+        static bool parse_eight_digits(const char* digits, std::uint64_t& value);
+        // Digits of a power-of-two radix with bits_per_digit bits each, without prefix
+        static std::vector<long long> power_of_two_to_vector(const char* first, const char* last, int bits_per_digit);
+
+        static std::string to_power_of_two_string(const bigint& input, int bits_per_digit, const char* prefix);
+
+        // Writes the nine zero-padded digits of a limb, two digits at a time
+        static void write_limb(char* out, std::uint32_t limb);
+
+        // Limbs per thread below which parallel formatting is not worth the hand-off
+        static constexpr std::size_t PARALLEL_FORMAT_THRESHOLD = std::size_t{1} << 16;
+
+        // Little-endian base 2^32 words of the magnitude, empty for zero
+        static std::vector<std::uint32_t> to_words(const std::vector<long long>& input);
+        static std::vector<long long> from_words(const std::vector<std::uint32_t>& input);
+
+        static std::vector<std::uint32_t> to_twos_complement(const bigint& input, std::size_t words);
+        static bigint from_twos_complement(std::vector<std::uint32_t> input);
+
+        template <typename Op>
+        static bigint bitwise(const bigint& lhs, const bigint& rhs, Op op) {
+            const std::size_t words = std::max(lhs.vec.size(), rhs.vec.size()) + 1;
+            auto result = to_twos_complement(lhs, words);
+            const auto other = to_twos_complement(rhs, words);
+            for (std::size_t i = 0; i < words; ++i) {
+                result[i] = op(result[i], other[i]);
+            }
+            return from_twos_complement(std::move(result));
+        }
+
+        // Multiply / floor-divide the magnitude by 2^bits in place, bits <= SHIFT_BITS
+        static constexpr std::size_t SHIFT_BITS = 29;
+        static void shift_left_small(std::vector<long long>& input, std::size_t bits);
+        static bool shift_right_small(std::vector<long long>& input, std::size_t bits);
+
+        // Per-thread buffers of the batch kernels; once grown, repeated batches stop allocating
+        struct batch_scratch
+        {
+            std::vector<std::uint64_t> a, b, product;
+            std::vector<long long> result, quotient;
+        };
+
+        static batch_scratch& scratch() {
+            thread_local batch_scratch buffers;
+            return buffers;
+        }
+
+        // Big-endian limbs and sign of one operand, held by a bigint or inside a bigint_array
+        struct limb_span
+        {
+            const long long* data;
+            std::size_t size;
+            bool negative;
+        };
+
+        using reversed_limbs = std::reverse_iterator<const long long*>;
+
+        static limb_span span_of(const bigint& value) {
+            return {value.vec.data(), value.vec.size(), value.is_neg};
+        }
+
+        static limb_span span_of(const bigint_array& array, std::size_t i);
+
+        static int compare_spans(const limb_span lhs, const limb_span rhs) {
+            if (lhs.negative != rhs.negative) return lhs.negative ? -1 : 1;
+            const int result = compare_magnitude(lhs.data, lhs.size, rhs.data, rhs.size);
+            return lhs.negative ? -result : result;
+        }
+
+        // The hash of std::hash<bigint>, shared with the elements of bigint_array
+        static std::size_t hash_limbs(limb_span value);
+
+        // Write the trimmed big-endian limbs of lhs op rhs to out, which must not alias the operands, and return the sign
+        static bool add_into(limb_span lhs, limb_span rhs, std::vector<long long>& out);
+        static bool multiply_into(limb_span lhs, limb_span rhs, std::vector<long long>& out);
+        static bool mod_into(limb_span lhs, limb_span rhs, std::vector<long long>& out);
+
+        // out = lhs op rhs in the existing storage of out, going through a scratch buffer when out aliases an operand
+        template <typename Kernel>
+        static void apply_into(const bigint& lhs, const bigint& rhs, bigint& out, Kernel kernel) {
+            const bool aliased = &out == &lhs || &out == &rhs;
+            auto& target = aliased ? scratch().result : out.vec;
+            const bool negative = kernel(span_of(lhs), span_of(rhs), target);
+            if (aliased) out.vec.assign(target.begin(), target.end());
+            out.is_neg = negative;
+        }
+
+        // Levels of a product tree with fewer limbs than this are multiplied on the calling thread
+        static constexpr std::size_t PARALLEL_PRODUCT_LIMBS = std::size_t{1} << 12;
+
+        static bigint product_tree(std::vector<bigint> level, std::size_t threads);
+
+        // Values per accumulator when a sum is split across the pool
+        static constexpr std::size_t SUM_CHUNK = 1024;
+
+        // Adds each value into little-endian signed columns without propagating carries
+        template <typename Iterator>
+        static void accumulate_columns(Iterator first, const Iterator last, std::vector<long long>& columns) {
+            for (; first != last; ++first) {
+                const bigint& value = *first;
+                const std::size_t n = value.vec.size();
+                if (columns.size() < n) columns.resize(n, 0);
+                if (value.is_neg) {
+                    for (std::size_t j = 0; j < n; ++j) columns[j] -= value.vec[n - 1 - j];
+                }
+                else {
+                    for (std::size_t j = 0; j < n; ++j) columns[j] += value.vec[n - 1 - j];
+                }
+            }
+        }
+
+        static bigint from_columns(std::vector<long long> columns);
+
+        template <typename Iterator>
+        static bigint sum_range(const Iterator first, const Iterator last, std::size_t, std::input_iterator_tag) {
+            std::vector<long long> columns;
+            accumulate_columns(first, last, columns);
+            return from_columns(std::move(columns));
+        }
+
+        template <typename Iterator>
+        static bigint sum_range(const Iterator first, const Iterator last, const std::size_t threads,
+                                std::random_access_iterator_tag) {
+            const auto count = static_cast<std::size_t>(last - first);
+            std::size_t chunks = threads == 1 ? 1 : count / SUM_CHUNK;
+            chunks = std::min(chunks, thread_pool::instance().size() + 1);
+            if (threads != 0) chunks = std::min(chunks, threads);
+            if (chunks <= 1) return sum_range(first, last, threads, std::input_iterator_tag());
+
+            std::vector<std::vector<long long>> partial(chunks);
+            thread_pool::instance().parallel_for(chunks, [&](const std::size_t i) {
+                const auto begin = static_cast<std::ptrdiff_t>(count * i / chunks);
+                const auto end = static_cast<std::ptrdiff_t>(count * (i + 1) / chunks);
+                accumulate_columns(first + begin, first + end, partial[i]);
+            }, chunks);
+
+            auto& columns = partial.front();
+            for (std::size_t i = 1; i < chunks; ++i) {
+                if (columns.size() < partial[i].size()) columns.resize(partial[i].size(), 0);
+                for (std::size_t j = 0; j < partial[i].size(); ++j) columns[j] += partial[i][j];
+            }
+            return from_columns(std::move(columns));
+        }
+
+        // Indices claimed by a worker at a time; smaller batches run on the calling thread
+        static constexpr std::size_t BATCH_GRAIN = 64;
+
+        // Runs kernel(i) for every index, in decreasing order of cost(i) when the costs differ
+        static void batch_run(std::size_t count, std::size_t threads, const std::function<std::size_t(std::size_t)>& cost,
+                              const std::function<void(std::size_t)>& kernel);
+
+        static void check_batch(const std::size_t lhs, const std::size_t rhs, const std::size_t out) {
+            if (lhs != out || rhs != out) throw std::invalid_argument("Batch operands differ in length.");
+        }
+
+        // Runs kernel over matching elements into a new array, sized from an upper bound on each result
+        template <typename Kernel, typename Bound, typename Cost>
+        static bigint_array batch_arrays(const bigint_array& a, const bigint_array& b, std::size_t threads,
+                                         Kernel kernel, Bound bound, Cost cost);
+
+        static bigint add(const bigint&, const bigint&);
+
+        static bigint subtract(const bigint&, const bigint&);
+
+        static bigint multiply(const bigint&, const bigint&);
+
+        /*
+         * Little-endian limb kernels, parametrized on the radix so the same code serves base 10^9 storage and
+         * base 2^32 conversions. Limbs are held in 64-bit words so that a limb product plus two limbs never overflows.
+         */
+        using limb_t = std::uint64_t;
+
+        struct decimal_radix
+        {
+            static constexpr limb_t base() { return MAX_SIZE; }
+        };
+
+        struct binary_radix
+        {
+            static constexpr limb_t base() { return 1ULL << 32; }
+        };
+
+        // Operands below this many limbs use schoolbook multiplication
+        static constexpr std::size_t KARATSUBA_THRESHOLD = 32;
+
+        // out[0 .. na + nb) = a * b, out must not alias the inputs
+        template <typename Radix>
+        static void multiply_limbs(const limb_t* a, std::size_t na, const limb_t* b, std::size_t nb, limb_t* out);
+
+        template <typename Radix>
+        static void multiply_schoolbook(const limb_t* a, std::size_t na, const limb_t* b, std::size_t nb, limb_t* out);
+
+        // out[0 .. 2n) = a * a, computing each cross product once
+        template <typename Radix>
+        static void square_schoolbook(const limb_t* a, std::size_t n, limb_t* out);
+
+        // a[0 .. na) += b[0 .. nb) with na >= nb, returns the carry out of the top limb
+        template <typename Radix>
+        static limb_t add_limbs(limb_t* a, std::size_t na, const limb_t* b, std::size_t nb);
+
+        // a[0 .. na) -= b[0 .. nb) with a >= b
+        template <typename Radix>
+        static void subtract_limbs(limb_t* a, std::size_t na, const limb_t* b, std::size_t nb);
+
+        static std::vector<limb_t> to_limbs(const std::vector<long long>& input) {
+            return {input.rbegin(), input.rend()};
+        }
+
+        static bigint from_limbs(const std::vector<limb_t>& input) {
+            auto top = input.rbegin();
+            while (top != input.rend() - 1 && *top == 0) ++top;
+            return bigint(std::vector<long long>(top, input.rend()));
+        }
+
+        // Cached base^(2^k) in the limbs of a radix, shared by pow, ilog and radix conversion.
+        // Entries are kept until the byte limit is reached; later squares are computed but not stored.
+        using power_limbs = std::shared_ptr<const std::vector<limb_t>>;
+
+        static constexpr std::size_t DEFAULT_POWER_CACHE_LIMIT = std::size_t{64} << 20;
+
+        struct power_table
+        {
+            std::mutex mutex;
+            std::map<std::tuple<limb_t, std::uint64_t, std::size_t>, power_limbs> entries;
+            std::size_t bytes = 0;
+            std::size_t limit = DEFAULT_POWER_CACHE_LIMIT;
+        };
+
+        static power_table& power_cache() {
+            static power_table table;
+            return table;
+        }
+
+        // base^(2^k), squaring previous = base^(2^(k-1)) on a miss when the caller already holds it
+        template <typename Radix>
+        static power_limbs square_power(std::uint64_t base, std::size_t k, const power_limbs& previous = nullptr);
+
+        // Radix conversion below this many limbs uses Horner's scheme, above it splits the number
+        // in halves around a cached power of the source base and recombines them with one multiplication
+        static constexpr std::size_t CONVERSION_THRESHOLD = 32;
+
+        // Little-endian Radix limbs of the little-endian base `from` digits d[0 .. n), without leading zeros;
+        // from must be at most 2^32 so that a limb times from plus a carry fits in 64 bits
+        template <typename Radix>
+        static std::vector<limb_t> convert_radix(const limb_t* d, std::size_t n, std::uint64_t from);
+
+        // Little-endian base `chunk` digits of a non-negative value, exactly `count` of them when count is non-zero.
+        // Splits around cached powers of chunk; reciprocals[k] holds the reciprocal of chunk^(2^k) once computed,
+        // so each level costs a few multiplications
+        static void to_chunks(const bigint& value, std::uint32_t chunk, std::size_t count, std::vector<bigint>& reciprocals,
+                              std::vector<std::uint32_t>& out);
+
+        // Divisors below this many limbs get their reciprocal from a single long division
+        static constexpr std::size_t NEWTON_THRESHOLD = 64;
+
+        // Radix conversion divides by powers of at least this many limbs through their reciprocal
+        static constexpr std::size_t RECIPROCAL_DIVISION_THRESHOLD = 512;
+
+        // value * MAX_SIZE^count, and value / MAX_SIZE^count truncated toward zero
+        static bigint shift_limbs(bigint value, std::size_t count);
+        static bigint drop_limbs(bigint value, std::size_t count);
+
+        // floor(MAX_SIZE^(2n) / divisor) for a positive divisor of n limbs, by Newton iteration from the
+        // reciprocal of its leading limbs
+        static bigint reciprocal(const bigint& divisor);
+
+        // Quotient and remainder of a non-negative value by a positive divisor whose reciprocal is known,
+        // in blocks of the divisor's length
+        static std::pair<bigint, bigint> divmod_reciprocal(const bigint& value, const bigint& divisor,
+                                                           const bigint& inverse);
+
+        // Value of an alphanumeric digit, 36 or more for anything else
+        static int digit_value(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+            return 36;
+        }
+
+        // base^exponent for a single-limb base; powers of two in the exponent come from the cache
+        static bigint pow_small(const bigint& base, const bigint& exponent);
+
+        // Natural logarithm of the magnitude from its two leading limbs, for estimates only
+        static double log_estimate(const bigint&);
+
+        // (F(n), L(n)) for n >= 0
+        static std::pair<bigint, bigint> fibonacci_lucas(const bigint& n);
+
+        // Product of first, first + step, ..., while <= last, with small factors packed into word-sized leaves
+        static bigint progression_product(std::uint64_t first, std::uint64_t last, std::uint64_t step);
+
+        // Character sources for read_number: peek() returns the next character or -1 at the end, bump() consumes it
+        struct stream_source
+        {
+            std::streambuf* buffer;
+
+            int peek() const {
+                const auto c = buffer->sgetc();
+                return c == std::char_traits<char>::eof() ? -1 : c;
+            }
+
+            void bump() const { buffer->sbumpc(); }
+        };
+
+        // Parses one number from source with the same rules as from_chars, keeping memory to the output limbs
+        template <typename Source>
+        static bool read_number(Source& source, bigint& value);
+
+        template <typename Source>
+        static bool read_decimal(Source& source, std::vector<long long>& limbs);
+
+        template <typename Source>
+        static bool read_power_of_two(Source& source, int bits_per_digit, std::vector<long long>& limbs);
+
+        static bool little_endian_host() {
+            const std::uint16_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }
+
+        static std::size_t words_bit_length(const std::vector<std::uint32_t>& words) {
+            std::size_t bits = words.size() * 32;
+            for (std::uint32_t top = words.empty() ? 0 : words.back(); bits > 0 && (top >> 31) == 0; top <<= 1) --bits;
+            return bits;
+        }
+
+        // Offset in a word array of the byte with significance index i, for the layout of import_words
+        static std::size_t byte_offset(std::size_t i, std::size_t count, std::size_t word_size, bool little, word_order order) {
+            const std::size_t word = i / word_size, byte = i % word_size;
+            const std::size_t slot = order == word_order::least_significant_first ? word : count - 1 - word;
+            return slot * word_size + (little ? byte : word_size - 1 - byte);
+        }
+
+        // LEB128 varints of the binary encoding
+        static void write_varint(std::uint64_t value, std::vector<std::uint8_t>& out);
+
+        static std::size_t varint_size(std::uint64_t value);
+
+        static std::uint64_t read_varint(const std::uint8_t*& first, const std::uint8_t* last);
+
+        // Appends the encoding of one value given by its limbs
+        static void serialize_limbs(limb_span value, std::vector<std::uint8_t>& out);
+
+        // Limb p of a view counting from the least significant end, zero past its top
+        static long long low_limb(const bigint_view& view, std::size_t p);
+
+        static int compare_views(const bigint_view& lhs, const bigint_view& rhs);
+
+        static void check_stream_factor(long long factor);
+
+        // lhs + rhs, with rhs taken as negative when rhs_negative is set
+        static void add_views(const bigint_view& lhs, const bigint_view& rhs, bool rhs_negative, const std::string& path);
+
+        // Writes the value whose limbs next() yields least significant first, at most limit of them
+        template <typename Generator>
+        static void write_streamed(bool negative, std::size_t limit, Generator next, const std::string& path);
+
+        // Value of a non-negative bigint that must fit in 64 bits
+        static std::uint64_t to_uint64(const bigint& input, const char* message) {
+            if (is_negative(input) || input.vec.size() > 2) {
+                throw std::domain_error(message);
+            }
+            std::uint64_t result = 0;
+            for (const auto limb : input.vec) {
+                result = result * MAX_SIZE + static_cast<std::uint64_t>(limb);
+            }
+            return result;
+        }
+
+        static bigint divide(const bigint& numerator, const bigint& denominator) {
+            return divmod(numerator, denominator).first;
+        }
+
+        static bigint mod(const bigint& lhs, const bigint& rhs) {
+            if (rhs == 0) { throw std::domain_error("Attempted to modulo by zero."); }
+            return divmod(lhs, rhs).second;
+        }
+
+        // Truncating division, the remainder takes the sign of the numerator
+        static std::pair<bigint, bigint> divmod(const bigint& numerator, const bigint& denominator);
+
+        // Long division of magnitudes (Knuth, TAOCP vol. 2, 4.3.1 Algorithm D)
+        static void divmod_limbs(const long long* numerator, std::size_t numerator_size,
+                                 const long long* denominator, std::size_t denominator_size,
+                                 std::vector<long long>& quotient, std::vector<long long>& remainder);
+
+        static int compare_magnitude(const long long* lhs, const std::size_t lhs_size,
+                                     const long long* rhs, const std::size_t rhs_size) {
+            if (lhs_size != rhs_size) {
+                return lhs_size < rhs_size ? -1 : 1;
+            }
+            for (std::size_t i = 0; i < lhs_size; ++i) {
+                if (lhs[i] != rhs[i]) {
+                    return lhs[i] < rhs[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        static int compare_magnitude(const std::vector<long long>& lhs, const std::vector<long long>& rhs) {
+            return compare_magnitude(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+        }
+
+
+
+        static int char_to_int(const char input) {
+            return input - '0';
+        }
+
+        static int int_to_char(const int input) {
+            return input + '0';
+        }
+
+        static bigint negate(const bigint& input) {
+            bigint temp = input;
+            temp.is_neg = !temp.is_neg;
+            return temp;
+        }
+
+        static bigint negate(bigint&& input) {
+            input.is_neg = !input.is_neg;
+            return input;
+        }
+
+        static int compare_integer(const bigint& lhs, const bool negative, unsigned long long magnitude) {
+            if (lhs.is_neg != negative) return lhs.is_neg ? -1 : 1;
+
+            // A 64-bit magnitude has at most three limbs, least significant first here
+            long long limbs[3] = {};
+            std::size_t count = 0;
+            do {
+                limbs[count++] = static_cast<long long>(magnitude % MAX_SIZE);
+                magnitude /= MAX_SIZE;
+            } while (magnitude != 0);
+
+            int result = 0;
+            if (lhs.vec.size() != count) {
+                result = lhs.vec.size() < count ? -1 : 1;
+            }
+            else {
+                for (std::size_t i = 0; i < count && result == 0; ++i) {
+                    const long long limb = limbs[count - 1 - i];
+                    if (lhs.vec[i] != limb) result = lhs.vec[i] < limb ? -1 : 1;
+                }
+            }
+            return negative ? -result : result;
+        }
+    };
+
+    /*
+     * Read-only view of one serialized bigint. Limbs are read from the input bytes on demand,
+     * so the bytes must outlive the view.
+     */
+    class bigint_view
+    {
+    public:
+        // Validates one encoded value at first and advances first past it
+        static bigint_view parse(const std::uint8_t*& first, const std::uint8_t* last);
+
+        bool is_negative() const { return negative; }
+
+        // Number of base 10^9 limbs
+        std::size_t size() const { return count; }
+
+        // Limb i, most significant first
+        std::uint32_t limb(std::size_t i) const;
+
+        bigint to_bigint() const;
+
+        explicit operator bigint() const { return to_bigint(); }
+
+    private:
+        const std::uint8_t* limbs = nullptr;
+        std::size_t count = 0;
+        std::uint64_t compact = 0;
+        bool negative = false;
+    };
+
+    /*
+     * Buffered reader for whitespace-separated numbers from a stream or, on POSIX systems, a file descriptor.
+     * Digits are folded into limbs as they arrive, so memory stays at the size of the result plus one chunk.
+     */
+    class bigint_reader
+    {
+    public:
+        static constexpr std::size_t DEFAULT_CHUNK_SIZE = std::size_t{1} << 16;
+
+        explicit bigint_reader(std::istream& stream, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE)
+            : stream(&stream), buffer(chunk_size) {}
+
+#ifdef BIGINT_POSIX
+        explicit bigint_reader(const int fd, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE)
+            : fd(fd), buffer(chunk_size) {}
+#endif
+
+        // Reads the next number into value, returns false at the end of the input
+        // @throws std::runtime_error if the next token is not a valid big integer
+        bool read(bigint& value);
+
+        int peek() {
+            if (position == filled && !refill()) return -1;
+            return static_cast<unsigned char>(buffer[position]);
+        }
+
+        void bump() { ++position; }
+
+    private:
+        bool refill();
+
+        std::istream* stream = nullptr;
+        int fd = -1;
+        std::vector<char> buffer;
+        std::size_t position = 0;
+        std::size_t filled = 0;
+    };
+
+    /*
+     * Owner of a file mapping holding one serialized bigint, handed out by bigint::map_file.
+     * The view reads limbs straight from the mapped pages and is valid for the lifetime of this object;
+     * bigint::add_to_file and the other streaming kernels compute on it without loading the value.
+     */
+    class mapped_bigint
+    {
+    public:
+        explicit mapped_bigint(const std::string& path);
+
+        mapped_bigint(const mapped_bigint&) = delete;
+        mapped_bigint& operator=(const mapped_bigint&) = delete;
+
+        mapped_bigint(mapped_bigint&& other) noexcept { swap(other); }
+
+        mapped_bigint& operator=(mapped_bigint&& other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~mapped_bigint() { release(); }
+
+        const bigint_view& view() const { return parsed; }
+
+        bigint to_bigint() const { return parsed.to_bigint(); }
+
+    private:
+        void release() noexcept;
+
+        void swap(mapped_bigint& other) noexcept {
+            std::swap(data, other.data);
+            std::swap(length, other.length);
+            std::swap(mapped, other.mapped);
+            std::swap(fallback, other.fallback);
+            std::swap(parsed, other.parsed);
+        }
+
+        const std::uint8_t* data = nullptr;
+        std::size_t length = 0;
+        bool mapped = false;
+        std::vector<std::uint8_t> fallback;
+        bigint_view parsed;
+    };
+
+    /*
+     * Column store for many bigints. The limbs of every element live back to back in one arena, with offset,
+     * length and sign side tables, so walking the array in order touches memory sequentially and appending
+     * costs no allocation per element. Elements are read through views.
+     */
+    class bigint_array
+    {
+    public:
+        // Read-only view of one element, valid until the array is modified
+        class element
+        {
+        public:
+            bool is_negative() const { return negative; }
+
+            // Number of base 10^9 limbs
+            std::size_t size() const { return count; }
+
+            // Limb i, most significant first
+            long long limb(const std::size_t i) const { return limbs[i]; }
+
+            const long long* data() const { return limbs; }
+
+            bigint to_bigint() const;
+
+            explicit operator bigint() const { return to_bigint(); }
+
+            // Equal to std::hash<bigint> of the same value
+            std::size_t hash() const;
+
+            static int compare(const element& lhs, const element& rhs);
+
+            friend bool operator==(const element& l, const element& r) { return compare(l, r) == 0; }
+            friend bool operator!=(const element& l, const element& r) { return compare(l, r) != 0; }
+            friend bool operator<(const element& l, const element& r) { return compare(l, r) < 0; }
+
+        private:
+            friend class bigint_array;
+
+            element(const long long* limbs, const std::size_t count, const bool negative)
+                : limbs(limbs), count(count), negative(negative) {}
+
+            const long long* limbs;
+            std::size_t count;
+            bool negative;
+        };
+
+        bigint_array() = default;
+
+        template <typename Iterator>
+        bigint_array(Iterator first, const Iterator last) {
+            for (; first != last; ++first) push_back(*first);
+        }
+
+        void reserve(const std::size_t elements, const std::size_t limbs) {
+            arena.reserve(limbs);
+            offsets.reserve(elements);
+            lengths.reserve(elements);
+            signs.reserve(elements);
+        }
+
+        void push_back(const bigint& value);
+
+        // Appends a serialized value without building a bigint first
+        void push_back(const bigint_view& value);
+
+        void clear() {
+            arena.clear();
+            offsets.clear();
+            lengths.clear();
+            signs.clear();
+        }
+
+        std::size_t size() const { return offsets.size(); }
+
+        bool empty() const { return offsets.empty(); }
+
+        // Total number of limbs held by the arena
+        std::size_t limb_count() const { return arena.size(); }
+
+        element operator[](const std::size_t i) const {
+            return element(arena.data() + offsets[i], lengths[i], signs[i] != 0);
+        }
+
+        element at(const std::size_t i) const {
+            if (i >= size()) throw std::out_of_range("bigint_array index out of range.");
+            return (*this)[i];
+        }
+
+        // Sorts by value and rewrites the arena in the new order, so elements stay contiguous and in sequence
+        void sort();
+
+        // Combines the element hashes in order
+        std::size_t hash() const;
+
+        // Appends the encoding of every element in order, each as written by bigint::serialize
+        void serialize(std::vector<std::uint8_t>& out) const;
+
+        // Decodes values up to last, throws std::runtime_error on malformed input
+        static bigint_array deserialize(const std::uint8_t* first, const std::uint8_t* last);
+
+    private:
+        friend class bigint;
+
+        std::vector<long long> arena;
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> lengths;
+        std::vector<std::uint8_t> signs;
+    };
+
+    // Overflow policies for fixed_bigint: wrap modulo 2^Bits, or throw std::overflow_error
+    struct wrapping_overflow
+    {
+        static constexpr bool checked = false;
+    };
+
+    struct checked_overflow
+    {
+        static constexpr bool checked = true;
+    };
+
+    /*
+     * Unsigned integer of exactly Bits bits kept in little-endian 32-bit words on the stack.
+     * Loops run over a compile-time word count, so the compiler can unroll them, and from C++14 on
+     * the arithmetic is usable in constant expressions.
+     */
+    template <std::size_t Bits, typename Policy = wrapping_overflow>
+    class fixed_bigint
+    {
+        static_assert(Bits > 0 && Bits % 32 == 0, "fixed_bigint width must be a positive multiple of 32 bits");
+
+    public:
+        static constexpr std::size_t word_count = Bits / 32;
+
+        constexpr fixed_bigint() : words{} {}
+
+        BIGINT_CONSTEXPR14 fixed_bigint(const std::uint64_t value) : words{} {
+            words[0] = static_cast<std::uint32_t>(value);
+            if (word_count > 1) {
+                words[word_count > 1 ? 1 : 0] = static_cast<std::uint32_t>(value >> 32);
+            }
+            else if (value >> 32 != 0) {
+                overflow();
+            }
+        }
+
+        // Reduces modulo 2^Bits, or throws for negative and out-of-range values under checked_overflow
+        explicit fixed_bigint(const bigint& value) : words{} {
+            const bool negative = value < 0;
+            const bigint magnitude = bigint::abs(value);
+            if (bigint::export_size(magnitude, 4) > word_count || negative) {
+                if (Policy::checked) overflow();
+                const bigint reduced = magnitude & ((bigint(1) << Bits) - 1);
+                bigint::export_words(reduced, words, word_count, 4);
+                if (negative) *this = -*this;
+                return;
+            }
+            bigint::export_words(magnitude, words, word_count, 4);
+        }
+
+        // Changes the width, dropping the high words or throwing for them under checked_overflow
+        template <std::size_t OtherBits, typename OtherPolicy>
+        explicit BIGINT_CONSTEXPR14 fixed_bigint(const fixed_bigint<OtherBits, OtherPolicy>& value) : words{} {
+            for (std::size_t i = 0; i < OtherBits / 32; ++i) {
+                if (i < word_count) words[i] = value.word(i);
+                else if (value.word(i) != 0) overflow();
+            }
+        }
+
+        bigint to_bigint() const {
+            return bigint::import_words(words, word_count, 4);
+        }
+
+        operator bigint() const { return to_bigint(); }
+
+        constexpr std::uint32_t word(const std::size_t i) const { return words[i]; }
+
+        static BIGINT_CONSTEXPR14 fixed_bigint max() {
+            fixed_bigint result;
+            for (std::size_t i = 0; i < word_count; ++i) result.words[i] = 0xFFFFFFFF;
+            return result;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator+=(const fixed_bigint& rhs) {
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < word_count; ++i) {
+                carry += static_cast<std::uint64_t>(words[i]) + rhs.words[i];
+                words[i] = static_cast<std::uint32_t>(carry);
+                carry >>= 32;
+            }
+            if (carry != 0) overflow();
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator-=(const fixed_bigint& rhs) {
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < word_count; ++i) {
+                const std::uint64_t sub = static_cast<std::uint64_t>(rhs.words[i]) + borrow;
+                borrow = words[i] < sub ? 1 : 0;
+                words[i] = static_cast<std::uint32_t>((static_cast<std::uint64_t>(words[i]) | borrow << 32) - sub);
+            }
+            if (borrow != 0) overflow();
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator*=(const fixed_bigint& rhs) {
+            // Schoolbook product; the words above Bits only matter for overflow checking
+            std::uint32_t product[2 * word_count] = {};
+            for (std::size_t i = 0; i < word_count; ++i) {
+                if (words[i] == 0) continue;
+                std::uint64_t carry = 0;
+                const std::size_t limit = Policy::checked ? word_count : word_count - i;
+                for (std::size_t j = 0; j < limit; ++j) {
+                    carry += static_cast<std::uint64_t>(words[i]) * rhs.words[j] + product[i + j];
+                    product[i + j] = static_cast<std::uint32_t>(carry);
+                    carry >>= 32;
+                }
+                if (Policy::checked) product[i + word_count] = static_cast<std::uint32_t>(carry);
+            }
+            for (std::size_t i = word_count; i < 2 * word_count; ++i) {
+                if (product[i] != 0) overflow();
+            }
+            for (std::size_t i = 0; i < word_count; ++i) words[i] = product[i];
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator/=(const fixed_bigint& rhs) {
+            *this = divmod(*this, rhs).first;
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator%=(const fixed_bigint& rhs) {
+            *this = divmod(*this, rhs).second;
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator&=(const fixed_bigint& rhs) {
+            for (std::size_t i = 0; i < word_count; ++i) words[i] &= rhs.words[i];
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator|=(const fixed_bigint& rhs) {
+            for (std::size_t i = 0; i < word_count; ++i) words[i] |= rhs.words[i];
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator^=(const fixed_bigint& rhs) {
+            for (std::size_t i = 0; i < word_count; ++i) words[i] ^= rhs.words[i];
+            return *this;
+        }
+
+        // Bits shifted out at the top are dropped under both policies, as for built-in unsigned types
+        BIGINT_CONSTEXPR14 fixed_bigint& operator<<=(const std::size_t shift) {
+            const std::size_t word_shift = shift / 32, bit_shift = shift % 32;
+            for (std::size_t i = word_count; i-- > 0;) {
+                std::uint32_t value = 0;
+                if (i >= word_shift) {
+                    value = words[i - word_shift] << bit_shift;
+                    if (bit_shift != 0 && i > word_shift) value |= words[i - word_shift - 1] >> (32 - bit_shift);
+                }
+                words[i] = value;
+            }
+            return *this;
+        }
+
+        BIGINT_CONSTEXPR14 fixed_bigint& operator>>=(const std::size_t shift) {
+            const std::size_t word_shift = shift / 32, bit_shift = shift % 32;
+            for (std::size_t i = 0; i < word_count; ++i) {
+                std::uint32_t value = 0;
+                if (i + word_shift < word_count) {
+                    value = words[i + word_shift] >> bit_shift;
+                    if (bit_shift != 0 && i + word_shift + 1 < word_count) value |= words[i + word_shift + 1] << (32 - bit_shift);
+                }
+                words[i] = value;
+            }
+            return *this;
+        }
+
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator+(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs += rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator-(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs -= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator*(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs *= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator/(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs /= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator%(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs %= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator&(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs &= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator|(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs |= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator^(fixed_bigint lhs, const fixed_bigint& rhs) { return lhs ^= rhs; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator<<(fixed_bigint lhs, const std::size_t shift) { return lhs <<= shift; }
+        friend BIGINT_CONSTEXPR14 fixed_bigint operator>>(fixed_bigint lhs, const std::size_t shift) { return lhs >>= shift; }
+
+        BIGINT_CONSTEXPR14 fixed_bigint operator~() const {
+            fixed_bigint result;
+            for (std::size_t i = 0; i < word_count; ++i) result.words[i] = ~words[i];
+            return result;
+        }
+
+        // Two's complement negation; only zero can be negated under checked_overflow
+        BIGINT_CONSTEXPR14 fixed_bigint operator-() const {
+            fixed_bigint result = ~*this;
+            std::uint64_t carry = 1;
+            for (std::size_t i = 0; i < word_count && carry != 0; ++i) {
+                carry += result.words[i];
+                result.words[i] = static_cast<std::uint32_t>(carry);
+                carry >>= 32;
+            }
+            if (carry == 0 && Policy::checked) overflow();
+            return result;
+        }
+
+        // Returns -1, 0 or 1, comparing from the most significant word down
+        static BIGINT_CONSTEXPR14 int compare(const fixed_bigint& lhs, const fixed_bigint& rhs) {
+            for (std::size_t i = word_count; i-- > 0;) {
+                if (lhs.words[i] != rhs.words[i]) return lhs.words[i] < rhs.words[i] ? -1 : 1;
+            }
+            return 0;
+        }
+
+        friend BIGINT_CONSTEXPR14 bool operator==(const fixed_bigint& l, const fixed_bigint& r) { return compare(l, r) == 0; }
+        friend BIGINT_CONSTEXPR14 bool operator!=(const fixed_bigint& l, const fixed_bigint& r) { return compare(l, r) != 0; }
+        friend BIGINT_CONSTEXPR14 bool operator<(const fixed_bigint& l, const fixed_bigint& r) { return compare(l, r) < 0; }
+        friend BIGINT_CONSTEXPR14 bool operator>(const fixed_bigint& l, const fixed_bigint& r) { return compare(l, r) > 0; }
+        friend BIGINT_CONSTEXPR14 bool operator<=(const fixed_bigint& l, const fixed_bigint& r) { return compare(l, r) <= 0; }
+        friend BIGINT_CONSTEXPR14 bool operator>=(const fixed_bigint& l, const fixed_bigint& r) { return compare(l, r) >= 0; }
+
+        // Bit-serial long division, throws std::domain_error for a zero divisor
+        static BIGINT_CONSTEXPR14 std::pair<fixed_bigint, fixed_bigint> divmod(const fixed_bigint& lhs, const fixed_bigint& rhs) {
+            if (rhs == fixed_bigint()) throw std::domain_error("Attempted to divide by zero.");
+            fixed_bigint quotient, remainder;
+            for (std::size_t bit = Bits; bit-- > 0;) {
+                remainder <<= 1;
+                remainder.words[0] |= (lhs.words[bit / 32] >> (bit % 32)) & 1;
+                if (remainder >= rhs) {
+                    remainder.subtract_unchecked(rhs);
+                    quotient.words[bit / 32] |= std::uint32_t{1} << (bit % 32);
+                }
+            }
+            return {quotient, remainder};
+        }
+
+        friend std::ostream& operator<<(std::ostream& stream, const fixed_bigint& n) {
+            return stream << n.to_bigint();
+        }
+
+    private:
+        static BIGINT_CONSTEXPR14 void overflow() {
+            if (Policy::checked) throw std::overflow_error("fixed_bigint overflow.");
+        }
+
+        BIGINT_CONSTEXPR14 void subtract_unchecked(const fixed_bigint& rhs) {
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < word_count; ++i) {
+                const std::uint64_t sub = static_cast<std::uint64_t>(rhs.words[i]) + borrow;
+                borrow = words[i] < sub ? 1 : 0;
+                words[i] = static_cast<std::uint32_t>((static_cast<std::uint64_t>(words[i]) | borrow << 32) - sub);
+            }
+        }
+
+        std::uint32_t words[word_count];
+    };
+
+    // Mixed expressions with bigint are evaluated in bigint
+    template <std::size_t Bits, typename Policy, typename T,
+              typename = typename std::enable_if<std::is_same<T, bigint>::value>::type>
+    bigint operator+(const fixed_bigint<Bits, Policy>& lhs, const T& rhs) { return lhs.to_bigint() + rhs; }
+
+    template <std::size_t Bits, typename Policy, typename T,
+              typename = typename std::enable_if<std::is_same<T, bigint>::value>::type>
+    bigint operator-(const fixed_bigint<Bits, Policy>& lhs, const T& rhs) { return lhs.to_bigint() - rhs; }
+
+    template <std::size_t Bits, typename Policy, typename T,
+              typename = typename std::enable_if<std::is_same<T, bigint>::value>::type>
+    bigint operator*(const fixed_bigint<Bits, Policy>& lhs, const T& rhs) { return lhs.to_bigint() * rhs; }
+
+    template <std::size_t Bits, typename Policy, typename T,
+              typename = typename std::enable_if<std::is_same<T, bigint>::value>::type>
+    bigint operator/(const fixed_bigint<Bits, Policy>& lhs, const T& rhs) { return lhs.to_bigint() / rhs; }
+
+    template <std::size_t Bits, typename Policy, typename T,
+              typename = typename std::enable_if<std::is_same<T, bigint>::value>::type>
+    bigint operator%(const fixed_bigint<Bits, Policy>& lhs, const T& rhs) { return lhs.to_bigint() % rhs; }
+
+    using uint128 = fixed_bigint<128>;
+    using uint256 = fixed_bigint<256>;
+    using uint512 = fixed_bigint<512>;
+    using uint1024 = fixed_bigint<1024>;
+
+#if __cplusplus >= 201402L
+    /*
+     * Compile-time literals, brought into scope with `using namespace BigInt::literals;`.
+     * Digits follow the rules for built-in integer literals: decimal, 0x/0X hex, 0b/0B binary,
+     * a leading 0 for octal, and ' separators. A negative constant is written as -123_big.
+     */
+    namespace literals {
+        constexpr unsigned literal_digit(const char c) {
+            return c >= '0' && c <= '9' ? static_cast<unsigned>(c - '0')
+                 : c >= 'a' && c <= 'f' ? static_cast<unsigned>(c - 'a' + 10)
+                 : c >= 'A' && c <= 'F' ? static_cast<unsigned>(c - 'A' + 10) : 16;
+        }
+
+        // Feeds each digit to Accumulator::push; a digit outside the radix fails the constant evaluation
+        template <typename Accumulator, char... Chars>
+        BIGINT_CONSTEXPR14 Accumulator parse_literal() {
+            const char text[] = {Chars...};
+            const std::size_t length = sizeof...(Chars);
+            unsigned radix = 10;
+            std::size_t i = 0;
+            if (length > 1 && text[0] == '0') {
+                if (text[1] == 'x' || text[1] == 'X') { radix = 16; i = 2; }
+                else if (text[1] == 'b' || text[1] == 'B') { radix = 2; i = 2; }
+                else { radix = 8; i = 1; }
+            }
+
+            Accumulator result{};
+            for (; i < length; ++i) {
+                if (text[i] == '\'') continue;
+                const unsigned digit = literal_digit(text[i]);
+                if (digit >= radix) throw std::runtime_error("Invalid Big Integer.");
+                result.push(radix, digit);
+            }
+            return result;
+        }
+
+        // Base 10^9 limbs, least significant first; at most 1.21 decimal digits per input character
+        template <std::size_t Capacity>
+        struct literal_limbs
+        {
+            long long value[Capacity];
+            std::size_t size;
+
+            BIGINT_CONSTEXPR14 void push(const unsigned radix, const unsigned digit) {
+                long long carry = digit;
+                for (std::size_t i = 0; i < size; ++i) {
+                    carry += value[i] * radix;
+                    value[i] = carry % 1000000000LL;
+                    carry /= 1000000000LL;
+                }
+                if (carry != 0) value[size++] = carry;
+            }
+        };
+
+        // Base 2^32 words, least significant first; four bits per input character bound every radix
+        template <std::size_t Capacity>
+        struct literal_words
+        {
+            std::uint32_t value[Capacity];
+            std::size_t size;
+
+            BIGINT_CONSTEXPR14 void push(const unsigned radix, const unsigned digit) {
+                std::uint64_t carry = digit;
+                for (std::size_t i = 0; i < size; ++i) {
+                    carry += static_cast<std::uint64_t>(value[i]) * radix;
+                    value[i] = static_cast<std::uint32_t>(carry);
+                    carry >>= 32;
+                }
+                if (carry != 0) value[size++] = static_cast<std::uint32_t>(carry);
+            }
+        };
+
+        template <char... Chars>
+        BIGINT_CONSTEXPR14 literal_words<(sizeof...(Chars) * 4 + 31) / 32> parse_words() {
+            return parse_literal<literal_words<(sizeof...(Chars) * 4 + 31) / 32>, Chars...>();
+        }
+
+        // The smallest multiple of 32 bits that holds the literal
+        template <char... Chars>
+        BIGINT_CONSTEXPR14 std::size_t literal_width() {
+            const std::size_t size = parse_words<Chars...>().size;
+            return (size == 0 ? 1 : size) * 32;
+        }
+
+        // The limbs are computed by the compiler; at run time only the copy into the vector remains
+        template <char... Chars>
+        bigint operator""_big() {
+            static constexpr auto limbs = parse_literal<literal_limbs<sizeof...(Chars) / 7 + 2>, Chars...>();
+            if (limbs.size == 0) return bigint();
+            return bigint(std::vector<long long>(std::reverse_iterator<const long long*>(limbs.value + limbs.size),
+                                                 std::reverse_iterator<const long long*>(limbs.value)));
+        }
+
+        // Usable in constant expressions; convert with an explicit fixed_bigint constructor to pick another width
+        template <char... Chars>
+        BIGINT_CONSTEXPR14 fixed_bigint<literal_width<Chars...>()> operator""_fixed() {
+            using result_type = fixed_bigint<literal_width<Chars...>()>;
+            const auto parsed = parse_words<Chars...>();
+            result_type result;
+            for (std::size_t i = parsed.size; i-- > 0;) result = (result << 32) | result_type(parsed.value[i]);
+            return result;
+        }
+    }
+#endif
+
+    inline bigint bigint::from_chars(const char* first, const char* last) {
+        bigint result;
+        result.is_neg = first != last && *first == '-';
+        if (result.is_neg) ++first;
+
+        const auto length = last - first;
+        if (length > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'b')) {
+            result.vec = power_of_two_to_vector(first + 2, last, first[1] == 'x' ? 4 : 1);
+        }
+        else {
+            result.vec = decimal_to_vector(first, last);
+        }
+
+        if (result.is_neg && result.vec.size() == 1 && result.vec.front() == 0) {
+            throw std::runtime_error("Invalid Big Integer.");
+        }
+        return result;
+    }
+
+    inline bigint bigint::add(const bigint& lhs, const bigint& rhs) {
+        bool negate_answer = false;
+        // Ensure both are positive
+        if (is_negative(lhs) && is_negative(rhs)) negate_answer = true;
+        else if (is_negative(lhs)) return subtract(rhs, abs(lhs));
+        else if (is_negative(rhs)) return subtract(lhs, abs(rhs));
+
+        // Ensure LHS is larger than RHS
+        if (lhs.vec.size() < rhs.vec.size()) return add(rhs, lhs);
+
+        // Prepare result vector with enough space (max size + 1 for potential carry)
+        std::vector<long long> result;
+        result.reserve(lhs.vec.size() + 1);
+
+        long long carry = 0;
+        auto it_l = lhs.vec.rbegin();
+        auto it_r = rhs.vec.rbegin();
+
+        while (it_l != lhs.vec.rend()) {
+            long long sum = *it_l + carry;
+            if (it_r != rhs.vec.rend()) {
+                sum += *it_r;
+                ++it_r;
+            }
+
+            if (sum >= MAX_SIZE) {
+                sum -= MAX_SIZE;
+                carry = 1;
+            }
+            else {
+                carry = 0;
+            }
+
+            result.push_back(sum);
+            ++it_l;
         }
 
         if (carry > 0) {
@@ -530,385 +2313,3088 @@ namespace BigInt {
         }
 
         std::reverse(result.begin(), result.end());
-        bigint result_bigint{std::move(result)};
-        return negate_answer ? negate(result_bigint) : result_bigint;
+        bigint result_bigint{std::move(result)};
+        return negate_answer ? negate(result_bigint) : result_bigint;
+    }
+
+    inline bigint bigint::subtract(const bigint& lhs, const bigint& rhs) {
+        // Ensure LHS is larger than RHS, and both are positive
+        // (-A) - (-B) == B - A
+        if (is_negative(lhs) && is_negative(rhs)) {
+            return subtract(abs(rhs), abs(lhs));
+        }
+        // (A) - (-B) == A + B
+        if (is_negative(rhs)) {
+            return add(lhs, abs(rhs));
+        }
+        // (-A) - (B) == -(A + B)
+        if (is_negative(lhs)) {
+            return negate(add(abs(lhs), rhs));
+        }
+        if (lhs < rhs) {
+            return negate(subtract(rhs, lhs));
+        }
+
+        std::vector<long long> result;
+        result.reserve(lhs.vec.size());
+        long long borrow = 0;
+
+        auto it_l = lhs.vec.rbegin();
+        auto it_r = rhs.vec.rbegin();
+
+        while (it_l != lhs.vec.rend()) {
+            const long long l_val = *it_l;
+            const long long r_val = (it_r != rhs.vec.rend()) ? *it_r : 0;
+
+            long long diff = l_val - r_val - borrow;
+            if (diff < 0) {
+                diff += MAX_SIZE;
+                borrow = 1;
+            }
+            else {
+                borrow = 0;
+            }
+            result.push_back(diff);
+
+            ++it_l;
+            if (it_r != rhs.vec.rend()) ++it_r;
+        }
+        std::reverse(result.begin(), result.end());
+        return trim(bigint(std::move(result)));
+    }
+
+    inline bigint bigint::multiply(const bigint& lhs, const bigint& rhs) {
+        if (lhs == 0 || rhs == 0) return 0;
+
+        bigint result;
+        if (lhs.vec.size() == 1 && rhs.vec.size() == 1) {
+            result = bigint(static_cast<unsigned long long>(lhs.vec.front() * rhs.vec.front()));
+        }
+        else {
+            const auto a = to_limbs(lhs.vec);
+            std::vector<limb_t> out(lhs.vec.size() + rhs.vec.size());
+            if (&lhs == &rhs || lhs.vec == rhs.vec) {
+                multiply_limbs<decimal_radix>(a.data(), a.size(), a.data(), a.size(), out.data());
+            }
+            else {
+                const auto b = to_limbs(rhs.vec);
+                multiply_limbs<decimal_radix>(a.data(), a.size(), b.data(), b.size(), out.data());
+            }
+            result = from_limbs(out);
+        }
+        result.is_neg = is_negative(lhs) != is_negative(rhs);
+        return result;
+    }
+
+    inline bigint bigint::product_tree(std::vector<bigint> level, const std::size_t threads) {
+        if (level.empty()) return 1;
+        std::size_t levels = 0, done = 0;
+        for (std::size_t width = level.size(); width > 1; width = (width + 1) / 2) ++levels;
+        while (level.size() > 1) {
+            report_progress(async_stage::product, static_cast<double>(done++) / levels);
+            const std::size_t pairs = level.size() / 2;
+            std::size_t limbs = 0;
+            for (const auto& value : level) limbs += value.vec.size();
+
+            std::vector<bigint> next(pairs + level.size() % 2);
+            const auto combine = [&](const std::size_t i) { next[i] = level[2 * i] * level[2 * i + 1]; };
+            if (threads != 1 && pairs > 1 && limbs >= PARALLEL_PRODUCT_LIMBS) {
+                thread_pool::instance().parallel_for(pairs, combine, threads);
+            }
+            else {
+                for (std::size_t i = 0; i < pairs; ++i) combine(i);
+            }
+            if (level.size() % 2 != 0) next.back() = std::move(level.back());
+            level = std::move(next);
+        }
+        return std::move(level.front());
+    }
+
+    inline bigint bigint::from_columns(std::vector<long long> columns) {
+        // Floor carries leave every column in [0, MAX_SIZE) and return what is left above the top column
+        const auto normalize = [](std::vector<long long>& limbs) {
+            long long carry = 0;
+            for (auto& limb : limbs) {
+                const long long value = limb + carry;
+                carry = value / MAX_SIZE;
+                limb = value % MAX_SIZE;
+                if (limb < 0) {
+                    limb += MAX_SIZE;
+                    --carry;
+                }
+            }
+            return carry;
+        };
+
+        long long carry = normalize(columns);
+        const bool negative = carry < 0;
+        if (negative) {
+            // A negative total: normalize its negation instead
+            for (auto& limb : columns) limb = -limb;
+            columns.push_back(-carry);
+            carry = normalize(columns);
+        }
+        for (; carry > 0; carry /= MAX_SIZE) columns.push_back(carry % MAX_SIZE);
+        while (columns.size() > 1 && columns.back() == 0) columns.pop_back();
+        if (columns.empty()) return 0;
+
+        std::reverse(columns.begin(), columns.end());
+        bigint result(std::move(columns));
+        result.is_neg = negative && result != 0;
+        return result;
+    }
+
+    inline bool bigint::add_into(const limb_span lhs, const limb_span rhs, std::vector<long long>& out) {
+        // Little-endian until the final reverse, built from the operand with the larger magnitude
+        bool negative = lhs.negative;
+        if (lhs.negative == rhs.negative) {
+            const limb_span& x = lhs.size >= rhs.size ? lhs : rhs;
+            const limb_span& y = lhs.size >= rhs.size ? rhs : lhs;
+            out.assign(reversed_limbs(x.data + x.size), reversed_limbs(x.data));
+            long long carry = 0;
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                if (i >= y.size && carry == 0) break;
+                out[i] += carry + (i < y.size ? y.data[y.size - 1 - i] : 0);
+                carry = out[i] >= MAX_SIZE;
+                if (carry) out[i] -= MAX_SIZE;
+            }
+            if (carry) out.push_back(1);
+        }
+        else {
+            const int order = compare_magnitude(lhs.data, lhs.size, rhs.data, rhs.size);
+            if (order == 0) {
+                out.assign(1, 0);
+                return false;
+            }
+            const limb_span& x = order > 0 ? lhs : rhs;
+            const limb_span& y = order > 0 ? rhs : lhs;
+            negative = x.negative;
+            out.assign(reversed_limbs(x.data + x.size), reversed_limbs(x.data));
+            long long borrow = 0;
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                if (i >= y.size && borrow == 0) break;
+                out[i] -= borrow + (i < y.size ? y.data[y.size - 1 - i] : 0);
+                borrow = out[i] < 0;
+                if (borrow) out[i] += MAX_SIZE;
+            }
+            while (out.size() > 1 && out.back() == 0) out.pop_back();
+        }
+        std::reverse(out.begin(), out.end());
+        return negative;
+    }
+
+    inline bool bigint::multiply_into(const limb_span lhs, const limb_span rhs, std::vector<long long>& out) {
+        const bool negative = lhs.negative != rhs.negative;
+        if (lhs.size == 1 && rhs.size == 1) {
+            const long long product = lhs.data[0] * rhs.data[0];
+            if (product >= MAX_SIZE) {
+                const long long limbs[2] = {product / MAX_SIZE, product % MAX_SIZE};
+                out.assign(limbs, limbs + 2);
+            }
+            else {
+                out.assign(1, product);
+            }
+            return negative && product != 0;
+        }
+
+        auto& buffers = scratch();
+        buffers.a.assign(reversed_limbs(lhs.data + lhs.size), reversed_limbs(lhs.data));
+        buffers.product.assign(lhs.size + rhs.size, 0);
+        if (lhs.data == rhs.data && lhs.size == rhs.size) {
+            multiply_limbs<decimal_radix>(buffers.a.data(), buffers.a.size(), buffers.a.data(), buffers.a.size(),
+                                          buffers.product.data());
+        }
+        else {
+            buffers.b.assign(reversed_limbs(rhs.data + rhs.size), reversed_limbs(rhs.data));
+            multiply_limbs<decimal_radix>(buffers.a.data(), buffers.a.size(), buffers.b.data(), buffers.b.size(),
+                                          buffers.product.data());
+        }
+
+        std::size_t top = buffers.product.size();
+        while (top > 1 && buffers.product[top - 1] == 0) --top;
+        out.assign(buffers.product.rend() - top, buffers.product.rend());
+        return negative && !(top == 1 && buffers.product.front() == 0);
+    }
+
+    inline bool bigint::mod_into(const limb_span lhs, const limb_span rhs, std::vector<long long>& out) {
+        if (rhs.size == 1 && rhs.data[0] == 0) throw std::domain_error("Attempted to modulo by zero.");
+        if (compare_magnitude(lhs.data, lhs.size, rhs.data, rhs.size) < 0) {
+            out.assign(lhs.data, lhs.data + lhs.size);
+            return lhs.negative;
+        }
+
+        if (rhs.size == 1) {
+            const long long divisor = rhs.data[0];
+            long long remainder = 0;
+            for (std::size_t i = 0; i < lhs.size; ++i) remainder = (remainder * MAX_SIZE + lhs.data[i]) % divisor;
+            out.assign(1, remainder);
+        }
+        else {
+            divmod_limbs(lhs.data, lhs.size, rhs.data, rhs.size, scratch().quotient, out);
+        }
+        return lhs.negative && !(out.size() == 1 && out.front() == 0);
+    }
+
+    inline void bigint::batch_run(const std::size_t count, const std::size_t threads,
+                                  const std::function<std::size_t(std::size_t)>& cost,
+                                  const std::function<void(std::size_t)>& kernel) {
+        if (count < 2 * BATCH_GRAIN || threads == 1) {
+            for (std::size_t i = 0; i < count; ++i) kernel(i);
+            return;
+        }
+
+        std::vector<std::size_t> order(count), weight(count);
+        bool uniform = true;
+        for (std::size_t i = 0; i < count; ++i) {
+            order[i] = i;
+            weight[i] = cost(i);
+            uniform = uniform && weight[i] == weight[0];
+        }
+        if (!uniform) {
+            std::stable_sort(order.begin(), order.end(),
+                             [&weight](const std::size_t l, const std::size_t r) { return weight[l] > weight[r]; });
+        }
+
+        const std::size_t chunks = (count + BATCH_GRAIN - 1) / BATCH_GRAIN;
+        thread_pool::instance().parallel_for(chunks, [&](const std::size_t chunk) {
+            const std::size_t end = std::min(count, (chunk + 1) * BATCH_GRAIN);
+            for (std::size_t i = chunk * BATCH_GRAIN; i < end; ++i) kernel(order[i]);
+        }, threads);
+    }
+
+    inline void bigint::batch_add(const bigint* a, const bigint* b, bigint* out, const std::size_t count,
+                                  const std::size_t threads) {
+        batch_run(count, threads,
+                  [=](const std::size_t i) { return std::max(a[i].vec.size(), b[i].vec.size()); },
+                  [=](const std::size_t i) { apply_into(a[i], b[i], out[i], add_into); });
+    }
+
+    inline void bigint::batch_mul(const bigint* a, const bigint* b, bigint* out, const std::size_t count,
+                                  const std::size_t threads) {
+        batch_run(count, threads,
+                  [=](const std::size_t i) { return a[i].vec.size() * b[i].vec.size(); },
+                  [=](const std::size_t i) { apply_into(a[i], b[i], out[i], multiply_into); });
+    }
+
+    inline void bigint::batch_mod(const bigint* a, const bigint* m, bigint* out, const std::size_t count,
+                                  const std::size_t threads) {
+        batch_run(count, threads,
+                  [=](const std::size_t i) { return a[i].vec.size() * m[i].vec.size(); },
+                  [=](const std::size_t i) { apply_into(a[i], m[i], out[i], mod_into); });
+    }
+
+    inline void bigint::batch_mod(const bigint* a, const bigint& modulus, bigint* out, const std::size_t count,
+                                  const std::size_t threads) {
+        if (modulus == 0) throw std::domain_error("Attempted to modulo by zero.");
+        // The modulus is copied so that out may alias it as well
+        const bigint m = modulus;
+        batch_run(count, threads,
+                  [=](const std::size_t i) { return a[i].vec.size(); },
+                  [=, &m](const std::size_t i) { apply_into(a[i], m, out[i], mod_into); });
+    }
+
+    template <typename Radix>
+    void bigint::multiply_schoolbook(const limb_t* a, const std::size_t na, const limb_t* b, const std::size_t nb, limb_t* out) {
+        std::fill(out, out + na + nb, 0);
+        for (std::size_t i = 0; i < na; ++i) {
+            if (a[i] == 0) continue;
+            limb_t carry = 0;
+            for (std::size_t j = 0; j < nb; ++j) {
+                const limb_t val = out[i + j] + a[i] * b[j] + carry;
+                out[i + j] = val % Radix::base();
+                carry = val / Radix::base();
+            }
+            out[i + nb] = carry;
+        }
+    }
+
+    template <typename Radix>
+    void bigint::square_schoolbook(const limb_t* a, const std::size_t n, limb_t* out) {
+        std::fill(out, out + 2 * n, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (a[i] == 0) continue;
+            limb_t carry = 0;
+            for (std::size_t j = i + 1; j < n; ++j) {
+                const limb_t val = out[i + j] + a[i] * a[j] + carry;
+                out[i + j] = val % Radix::base();
+                carry = val / Radix::base();
+            }
+            out[i + n] = carry;
+        }
+
+        // Double the cross products and add the squares on the diagonal
+        limb_t carry = 0;
+        for (std::size_t i = 0; i < 2 * n; ++i) {
+            const limb_t val = 2 * out[i] + carry;
+            out[i] = val % Radix::base();
+            carry = val / Radix::base();
+        }
+        carry = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            limb_t val = out[2 * i] + a[i] * a[i] + carry;
+            out[2 * i] = val % Radix::base();
+            val = out[2 * i + 1] + val / Radix::base();
+            out[2 * i + 1] = val % Radix::base();
+            carry = val / Radix::base();
+        }
+    }
+
+    template <typename Radix>
+    bigint::limb_t bigint::add_limbs(limb_t* a, const std::size_t na, const limb_t* b, const std::size_t nb) {
+        limb_t carry = 0;
+        std::size_t i = 0;
+        for (; i < nb; ++i) {
+            a[i] += b[i] + carry;
+            carry = a[i] >= Radix::base();
+            if (carry) a[i] -= Radix::base();
+        }
+        for (; carry != 0 && i < na; ++i) {
+            a[i] += carry;
+            carry = a[i] >= Radix::base();
+            if (carry) a[i] -= Radix::base();
+        }
+        return carry;
+    }
+
+    template <typename Radix>
+    void bigint::subtract_limbs(limb_t* a, const std::size_t na, const limb_t* b, const std::size_t nb) {
+        limb_t borrow = 0;
+        std::size_t i = 0;
+        for (; i < nb; ++i) {
+            const limb_t sub = b[i] + borrow;
+            borrow = a[i] < sub;
+            a[i] = a[i] + (borrow ? Radix::base() : 0) - sub;
+        }
+        for (; borrow != 0 && i < na; ++i) {
+            borrow = a[i] == 0;
+            a[i] = borrow ? Radix::base() - 1 : a[i] - 1;
+        }
+    }
+
+    template <typename Radix>
+    void bigint::multiply_limbs(const limb_t* a, std::size_t na, const limb_t* b, std::size_t nb, limb_t* out) {
+        if (na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        const bool squaring = a == b && na == nb;
+        if (nb < KARATSUBA_THRESHOLD) {
+            if (squaring) {
+                square_schoolbook<Radix>(a, na, out);
+            }
+            else {
+                multiply_schoolbook<Radix>(a, na, b, nb, out);
+            }
+            return;
+        }
+        cancellation_point();
+
+        // Unbalanced operands: multiply b by nb-sized slices of a
+        if (na >= 2 * nb) {
+            std::fill(out, out + na + nb, 0);
+            std::vector<limb_t> partial(2 * nb);
+            const std::size_t slices = (na + nb - 1) / nb;
+            for (std::size_t offset = 0; offset < na; offset += nb) {
+                const std::size_t slice = std::min(nb, na - offset);
+                {
+                    const progress_slice share(offset / nb, slices);
+                    multiply_limbs<Radix>(a + offset, slice, b, nb, partial.data());
+                }
+                add_limbs<Radix>(out + offset, na + nb - offset, partial.data(), slice + nb);
+            }
+            return;
+        }
+
+        // Karatsuba: a = a1 B^h + a0, b = b1 B^h + b0, a b = z2 B^2h + (z1 - z2 - z0) B^h + z0 with z1 = (a0 + a1)(b0 + b1)
+        const std::size_t h = na / 2;
+        const std::size_t na1 = na - h, nb1 = nb - h;
+
+        std::vector<limb_t> sum_a(a, a + h), sum_b(b, b + h);
+        sum_a.resize(na1 + 1, 0);
+        sum_b.resize(std::max(h, nb1) + 1, 0);
+        add_limbs<Radix>(sum_a.data(), sum_a.size(), a + h, na1);
+        add_limbs<Radix>(sum_b.data(), sum_b.size(), b + h, nb1);
+
+        // Squaring keeps both operands identical so every sub-product is a square as well
+        if (squaring) sum_b = sum_a;
+        std::vector<limb_t> middle(sum_a.size() + sum_b.size());
+        const limb_t* middle_b = squaring ? sum_a.data() : sum_b.data();
+        {
+            const progress_slice share(0, 3);
+            multiply_limbs<Radix>(sum_a.data(), sum_a.size(), middle_b, sum_b.size(), middle.data());
+        }
+
+        // z0 and z2 land directly in their final positions
+        std::fill(out, out + na + nb, 0);
+        {
+            const progress_slice share(1, 3);
+            multiply_limbs<Radix>(a, h, b, h, out);
+        }
+        {
+            const progress_slice share(2, 3);
+            multiply_limbs<Radix>(a + h, na1, b + h, nb1, out + 2 * h);
+        }
+
+        subtract_limbs<Radix>(middle.data(), middle.size(), out, 2 * h);
+        subtract_limbs<Radix>(middle.data(), middle.size(), out + 2 * h, na1 + nb1);
+
+        std::size_t used = middle.size();
+        while (used > 0 && middle[used - 1] == 0) --used;
+        add_limbs<Radix>(out + h, na + nb - h, middle.data(), used);
+    }
+
+    inline std::pair<bigint, bigint> bigint::divmod(const bigint& numerator, const bigint& denominator) {
+        if (denominator == 0) {
+            throw std::domain_error("Attempted to divide by zero.");
+        }
+        if (compare_magnitude(numerator.vec, denominator.vec) < 0) {
+            return {0, numerator};
+        }
+
+        std::vector<long long> quotient, remainder;
+        divmod_limbs(numerator.vec.data(), numerator.vec.size(), denominator.vec.data(), denominator.vec.size(),
+                     quotient, remainder);
+
+        std::pair<bigint, bigint> result{bigint(std::move(quotient)), bigint(std::move(remainder))};
+        result.first.is_neg = numerator.is_neg != denominator.is_neg && result.first != 0;
+        result.second.is_neg = numerator.is_neg && result.second != 0;
+        return result;
+    }
+
+    inline void bigint::divmod_limbs(const long long* numerator, const std::size_t numerator_size,
+                                     const long long* denominator, const std::size_t denominator_size,
+                                     std::vector<long long>& quotient, std::vector<long long>& remainder) {
+        // Work little-endian so that limb i has weight MAX_SIZE^i
+        std::vector<long long> u(reversed_limbs(numerator + numerator_size), reversed_limbs(numerator));
+        std::vector<long long> v(reversed_limbs(denominator + denominator_size), reversed_limbs(denominator));
+        const std::size_t n = v.size();
+        const std::size_t m = u.size() - n;
+        std::vector<long long> q(m + 1, 0);
+
+        if (n == 1) {
+            long long rem = 0;
+            for (std::size_t i = u.size(); i-- > 0;) {
+                const long long cur = rem * MAX_SIZE + u[i];
+                q[i] = cur / v[0];
+                rem = cur % v[0];
+            }
+            remainder.assign(1, rem);
+        }
+        else {
+            // Normalize so the leading divisor limb is at least MAX_SIZE / 2
+            const long long scale = MAX_SIZE / (v[n - 1] + 1);
+            const auto scale_by = [scale](std::vector<long long>& limbs) {
+                long long carry = 0;
+                for (auto& limb : limbs) {
+                    const long long val = limb * scale + carry;
+                    limb = val % MAX_SIZE;
+                    carry = val / MAX_SIZE;
+                }
+                return carry;
+            };
+            u.push_back(scale_by(u));
+            scale_by(v);
+
+            for (std::size_t j = m + 1; j-- > 0;) {
+                if ((m - j) % 64 == 0) report_progress(async_stage::division, static_cast<double>(m - j) / (m + 1));
+                const long long top = u[j + n] * MAX_SIZE + u[j + n - 1];
+                long long q_hat = top / v[n - 1];
+                long long r_hat = top % v[n - 1];
+                while (q_hat >= MAX_SIZE || q_hat * v[n - 2] > r_hat * MAX_SIZE + u[j + n - 2]) {
+                    --q_hat;
+                    r_hat += v[n - 1];
+                    if (r_hat >= MAX_SIZE) break;
+                }
+
+                // u[j .. j+n] -= q_hat * v
+                long long carry = 0, borrow = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const long long product = q_hat * v[i] + carry;
+                    carry = product / MAX_SIZE;
+                    long long diff = u[i + j] - product % MAX_SIZE - borrow;
+                    borrow = diff < 0;
+                    if (borrow) diff += MAX_SIZE;
+                    u[i + j] = diff;
+                }
+                long long top_diff = u[j + n] - carry - borrow;
+
+                // q_hat was one too large, add the divisor back
+                if (top_diff < 0) {
+                    --q_hat;
+                    carry = 0;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        long long sum = u[i + j] + v[i] + carry;
+                        carry = sum >= MAX_SIZE;
+                        if (carry) sum -= MAX_SIZE;
+                        u[i + j] = sum;
+                    }
+                    top_diff += carry;
+                }
+                u[j + n] = top_diff;
+                q[j] = q_hat;
+            }
+
+            // Undo the normalization on the remainder
+            remainder.assign(n, 0);
+            long long rem = 0;
+            for (std::size_t i = n; i-- > 0;) {
+                const long long cur = rem * MAX_SIZE + u[i];
+                remainder[n - 1 - i] = cur / scale;
+                rem = cur % scale;
+            }
+        }
+
+        while (q.size() > 1 && q.back() == 0) {
+            q.pop_back();
+        }
+        quotient.assign(q.rbegin(), q.rend());
+        const auto first = std::find_if(remainder.begin(), remainder.end() - 1, [](const long long x) { return x != 0; });
+        remainder.erase(remainder.begin(), first);
+    }
+
+    inline bigint bigint::sqrt(const bigint& input) {
+        if (is_negative(input))
+            throw std::domain_error("Square root of a negative number is complex");
+
+        if (input == 0 || input == 1)
+            return input;
+
+        bigint oom = log10(input / 2);
+        oom /= 2;
+        bigint low_end = pow(10, (oom));
+        bigint high_end = pow(10, (oom) + 2);
+        bigint mid_point, square, answer;
+        while (low_end <= high_end) {
+            mid_point = (low_end + high_end) / 2;
+            square = mid_point * mid_point;
+            if (square == input)
+                return mid_point;
+
+            if (square < input) {
+                low_end = mid_point + 1;
+                answer = mid_point;
+            }
+            else {
+                high_end = mid_point - 1;
+            }
+        }
+        return answer;
+    }
+
+    inline bigint bigint::log2(const bigint& input) {
+        if (is_negative(input) || input == 0)
+            throw std::domain_error("Invalid input for natural log");
+
+        return ilog(input, 2);
+    }
+
+    inline bigint bigint::log10(const bigint& input) {
+        if (is_negative(input) || input == 0)
+            throw std::domain_error("Invalid input for log base 10");
+
+        return bigint(static_cast<unsigned long long>(decimal_digits(input.vec.size(), input.vec.front()) - 1));
+    }
+
+    inline bigint bigint::logwithbase(const bigint& input, const bigint& base) {
+        return ilog(input, base);
+    }
+
+    inline double bigint::log_estimate(const bigint& input) {
+        double leading = static_cast<double>(input.vec.front());
+        std::size_t remaining = input.vec.size() - 1;
+        if (remaining > 0) {
+            leading = leading * MAX_SIZE + static_cast<double>(input.vec[1]);
+            --remaining;
+        }
+        return std::log(leading) + static_cast<double>(remaining) * 9 * std::log(10.0);
+    }
+
+    inline std::size_t bigint::ilog(const bigint& n, const bigint& base) {
+        if (is_negative(n) || n == 0)
+            throw std::domain_error("Logarithm of a non-positive number is undefined");
+        if (base < 2)
+            throw std::domain_error("Logarithm base must be at least 2");
+
+        if (base == 10) return decimal_digits(n.vec.size(), n.vec.front()) - 1;
+        if (compare(n, base) < 0) return 0;
+        if (n.vec.size() == 1 && base.vec.size() == 1) {
+            std::size_t result = 0;
+            for (long long value = n.vec.back(); value >= base.vec.back(); value /= base.vec.back()) ++result;
+            return result;
+        }
+
+        // The estimate is off by at most one or two for any input that fits in memory;
+        // step it to the exact value with single multiplications and divisions by the base
+        const double estimate = log_estimate(n) / log_estimate(base);
+        std::size_t result = estimate < 1 ? 1 : static_cast<std::size_t>(estimate);
+        bigint power = pow(base, static_cast<long long>(result));
+        while (compare_magnitude(power.vec, n.vec) > 0) {
+            power = power / base;
+            --result;
+        }
+        for (bigint next = power * base; compare_magnitude(next.vec, n.vec) <= 0; next = next * base) {
+            ++result;
+        }
+        return result;
+    }
+
+    inline std::size_t bigint::bit_length(const bigint& input) {
+        if (input == 0) return 0;
+        return ilog(abs(input), 2) + 1;
+    }
+
+    inline bigint bigint::antilog2(const bigint& input) {
+        return pow(2, input);
+    }
+
+    inline bigint bigint::antilog10(const bigint& input) {
+        return pow(10, input);
+    }
+
+    inline void bigint::set_power_cache_limit(const std::size_t bytes) {
+        auto& cache = power_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.limit = bytes;
+        if (cache.bytes > bytes) {
+            cache.entries.clear();
+            cache.bytes = 0;
+        }
+    }
+
+    inline std::size_t bigint::power_cache_limit() {
+        auto& cache = power_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        return cache.limit;
+    }
+
+    inline void bigint::clear_power_cache() {
+        auto& cache = power_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.entries.clear();
+        cache.bytes = 0;
+    }
+
+    template <typename Radix>
+    bigint::power_limbs bigint::square_power(const std::uint64_t base, const std::size_t k, const power_limbs& previous) {
+        auto& cache = power_cache();
+        const auto key = std::make_tuple(Radix::base(), base, k);
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            const auto found = cache.entries.find(key);
+            if (found != cache.entries.end()) return found->second;
+        }
+
+        std::vector<limb_t> value;
+        if (k == 0) {
+            for (std::uint64_t rest = base; rest > 0; rest /= Radix::base()) {
+                value.push_back(rest % Radix::base());
+            }
+        }
+        else {
+            const auto half = previous ? previous : square_power<Radix>(base, k - 1);
+            value.resize(2 * half->size());
+            multiply_limbs<Radix>(half->data(), half->size(), half->data(), half->size(), value.data());
+            while (value.size() > 1 && value.back() == 0) value.pop_back();
+        }
+
+        const auto bytes = value.size() * sizeof(limb_t);
+        power_limbs result = std::make_shared<const std::vector<limb_t>>(std::move(value));
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (cache.bytes + bytes <= cache.limit) {
+            const auto inserted = cache.entries.emplace(key, result);
+            if (!inserted.second) return inserted.first->second;
+            cache.bytes += bytes;
+        }
+        return result;
+    }
+
+    inline bigint bigint::pow_small(const bigint& base, const bigint& exponent) {
+        const auto bits = to_words(exponent.vec);
+        std::size_t length = (bits.size() - 1) * 32;
+        for (std::uint32_t top = bits.back(); top != 0; top >>= 1) ++length;
+        const auto value = static_cast<std::uint64_t>(base.vec.front());
+        const bool negative = is_negative(base) && (bits.front() & 1);
+
+        // Powers of two of the exponent are the ones radix conversion and ilog ask for repeatedly
+        if (popcount(exponent) == 1) {
+            // Built one squaring at a time, so each is a stage of an asynchronous pow
+            power_limbs power = square_power<decimal_radix>(value, 0);
+            for (std::size_t k = 1; k < length; ++k) {
+                report_progress(async_stage::power, static_cast<double>(k - 1) / (length - 1));
+                power = square_power<decimal_radix>(value, k, power);
+            }
+            bigint answer = from_limbs(*power);
+            answer.is_neg = negative;
+            return answer;
+        }
+
+        // Left-to-right square and multiply, so every large product is a squaring
+        std::vector<limb_t> result{value}, product;
+        for (std::size_t k = length - 1; k-- > 0;) {
+            report_progress(async_stage::power, static_cast<double>(length - 1 - k) / length);
+            product.assign(2 * result.size(), 0);
+            multiply_limbs<decimal_radix>(result.data(), result.size(), result.data(), result.size(), product.data());
+            if ((bits[k / 32] >> (k % 32)) & 1) {
+                limb_t carry = 0;
+                for (auto& limb : product) {
+                    const limb_t val = limb * value + carry;
+                    limb = val % decimal_radix::base();
+                    carry = val / decimal_radix::base();
+                }
+                product.push_back(carry);
+            }
+            while (product.size() > 1 && product.back() == 0) product.pop_back();
+            result.swap(product);
+        }
+
+        bigint answer = from_limbs(result);
+        answer.is_neg = negative;
+        return answer;
+    }
+
+    inline void bigint::swap(bigint& lhs, bigint& rhs) {
+        const bigint temp = lhs;
+        lhs = rhs;
+        rhs = temp;
+    }
+
+    // Binary GCD (Stein's algorithm) over base 2^32 words, using only shifts and subtractions
+    inline bigint bigint::gcd(const bigint& lhs, const bigint& rhs) {
+        if (lhs == 0) return abs(rhs);
+        if (rhs == 0) return abs(lhs);
+
+        auto u = to_words(lhs.vec);
+        auto v = to_words(rhs.vec);
+
+        const auto trailing = [](const std::vector<std::uint32_t>& words) {
+            std::size_t count = 0;
+            auto it = words.begin();
+            for (; *it == 0; ++it) count += 32;
+            for (std::uint32_t word = *it; (word & 1) == 0; word >>= 1) ++count;
+            return count;
+        };
+        const auto shift_right = [](std::vector<std::uint32_t>& words, const std::size_t shift) {
+            const std::size_t skip = shift / 32, bits = shift % 32;
+            for (std::size_t i = 0; i + skip < words.size(); ++i) {
+                const std::uint32_t high = bits != 0 && i + skip + 1 < words.size() ? words[i + skip + 1] << (32 - bits) : 0;
+                words[i] = (words[i + skip] >> bits) | high;
+            }
+            words.resize(words.size() - skip);
+            while (!words.empty() && words.back() == 0) words.pop_back();
+        };
+        const auto less = [](const std::vector<std::uint32_t>& a, const std::vector<std::uint32_t>& b) {
+            if (a.size() != b.size()) return a.size() < b.size();
+            return std::lexicographical_compare(a.rbegin(), a.rend(), b.rbegin(), b.rend());
+        };
+
+        const std::size_t u_zeros = trailing(u), v_zeros = trailing(v);
+        const std::size_t common = std::min(u_zeros, v_zeros);
+        shift_right(u, u_zeros);
+        shift_right(v, v_zeros);
+
+        // Both odd from here on, so v - u is even and non-negative after ordering
+        while (!v.empty()) {
+            if (less(v, u)) std::swap(u, v);
+            std::int64_t borrow = 0;
+            for (std::size_t i = 0; i < v.size(); ++i) {
+                const std::int64_t diff = static_cast<std::int64_t>(v[i]) - (i < u.size() ? u[i] : 0) - borrow;
+                borrow = diff < 0;
+                v[i] = static_cast<std::uint32_t>(diff);
+            }
+            while (!v.empty() && v.back() == 0) v.pop_back();
+            if (!v.empty()) shift_right(v, trailing(v));
+        }
+
+        return bigint(from_words(u)) << common;
+    }
+
+    inline std::tuple<bigint, bigint, bigint> bigint::gcdext(const bigint& lhs, const bigint& rhs) {
+        bigint old_r = abs(lhs), r = abs(rhs);
+        bigint old_s = 1, s = 0;
+        bigint old_t = 0, t = 1;
+
+        while (r != 0) {
+            auto qr = divmod(old_r, r);
+            old_r = std::move(r);
+            r = std::move(qr.second);
+
+            bigint next_s = old_s - qr.first * s;
+            old_s = std::move(s);
+            s = std::move(next_s);
+
+            bigint next_t = old_t - qr.first * t;
+            old_t = std::move(t);
+            t = std::move(next_t);
+        }
+
+        // Coefficients were computed for |lhs| and |rhs|
+        if (is_negative(lhs)) old_s = -old_s;
+        if (is_negative(rhs)) old_t = -old_t;
+        return std::make_tuple(old_r, old_s, old_t);
+    }
+
+    inline bigint bigint::modinv(const bigint& value, const bigint& modulus) {
+        if (modulus <= 0) {
+            throw std::domain_error("Modulus must be positive.");
+        }
+        if (modulus == 1) return 0;
+
+        bigint reduced = value % modulus;
+        if (is_negative(reduced)) reduced += modulus;
+
+        const auto result = gcdext(reduced, modulus);
+        if (std::get<0>(result) != 1) {
+            throw std::domain_error("Modular inverse does not exist.");
+        }
+        bigint inverse = std::get<1>(result) % modulus;
+        if (is_negative(inverse)) inverse += modulus;
+        return inverse;
+    }
+
+    inline bigint bigint::progression_product(std::uint64_t first, const std::uint64_t last, const std::uint64_t step) {
+        // Leaves stay below 10^18 so they fit in two limbs
+        constexpr std::uint64_t leaf_limit = 1000000000000000000ULL;
+        std::vector<bigint> leaves;
+        std::uint64_t leaf = 1;
+        for (; first <= last; first += step) {
+            if (leaf > (leaf_limit - 1) / first) {
+                leaves.emplace_back(static_cast<unsigned long long>(leaf));
+                leaf = 1;
+            }
+            leaf *= first;
+            if (last - first < step) break;
+        }
+        leaves.emplace_back(static_cast<unsigned long long>(leaf));
+        return product(leaves.begin(), leaves.end());
+    }
+
+    inline bigint bigint::factorial(const bigint& input) {
+        if (is_negative(input)) {
+            throw std::runtime_error("Factorial of Negative Integer is not defined.");
+        }
+        const std::uint64_t n = to_uint64(input, "Factorial argument is too large.");
+        if (n < 2)
+            return 1;
+
+        return progression_product(2, n, 1);
+    }
+
+    inline void bigint::report_progress(const async_stage stage, const double fraction) {
+        async_context* context = current_async();
+        if (context == nullptr) return;
+        if (context->token.is_cancelled()) throw operation_cancelled();
+        if (context->owner == async_stage::none) context->owner = stage;
+        // Steps below a thousandth are dropped, so fine-grained stages do not flood the callback
+        if (context->owner != stage || !context->progress || fraction < context->reported + 0.001) return;
+        context->reported = fraction;
+        context->progress(fraction);
+    }
+
+    template <typename T>
+    std::function<T()> bigint::async_task(std::function<T()> work, cancellation_token token,
+                                          progress_callback progress) {
+        // Shared so that copies of the task do not copy the operands bound into work
+        const auto shared = std::make_shared<std::function<T()>>(std::move(work));
+        return [shared, token, progress]() -> T {
+            async_context context{token, progress, async_stage::none, 0.0, 0.0, 1.0};
+            struct scope
+            {
+                async_context* previous;
+
+                explicit scope(async_context* installed) : previous(current_async()) {
+                    current_async() = installed;
+                }
+
+                ~scope() {
+                    current_async() = previous;
+                }
+            } installed(&context);
+
+            cancellation_point();
+            T result = (*shared)();
+            if (context.progress && context.reported < 1) context.progress(1);
+            return result;
+        };
+    }
+
+    inline std::future<bigint> bigint::async_multiply(bigint lhs, bigint rhs, cancellation_token token,
+                                                      progress_callback progress) {
+        const auto work = std::bind([](const bigint& a, const bigint& b) { return a * b; }, std::move(lhs), std::move(rhs));
+        return thread_pool::instance().submit(async_task<bigint>(work, std::move(token), std::move(progress)));
+    }
+
+    inline std::future<bigint> bigint::async_pow(bigint base, bigint exponent, cancellation_token token,
+                                                 progress_callback progress) {
+        const auto work = std::bind(&bigint::pow, std::move(base), std::move(exponent));
+        return thread_pool::instance().submit(async_task<bigint>(work, std::move(token), std::move(progress)));
+    }
+
+    inline std::future<bigint> bigint::async_factorial(bigint n, cancellation_token token, progress_callback progress) {
+        const auto work = std::bind(&bigint::factorial, std::move(n));
+        return thread_pool::instance().submit(async_task<bigint>(work, std::move(token), std::move(progress)));
+    }
+
+    inline std::future<std::pair<bigint, bigint>> bigint::async_divmod(bigint numerator, bigint denominator,
+                                                                       cancellation_token token,
+                                                                       progress_callback progress) {
+        const auto work = std::bind(&bigint::divmod, std::move(numerator), std::move(denominator));
+        return thread_pool::instance().submit(
+            async_task<std::pair<bigint, bigint>>(work, std::move(token), std::move(progress)));
+    }
+
+#if __cplusplus >= 202002L
+    inline async_operation<bigint> bigint::co_multiply(bigint lhs, bigint rhs, cancellation_token token,
+                                                       progress_callback progress) {
+        const auto work = std::bind([](const bigint& a, const bigint& b) { return a * b; }, std::move(lhs), std::move(rhs));
+        return async_operation<bigint>(async_task<bigint>(work, std::move(token), std::move(progress)));
+    }
+
+    inline async_operation<bigint> bigint::co_pow(bigint base, bigint exponent, cancellation_token token,
+                                                  progress_callback progress) {
+        const auto work = std::bind(&bigint::pow, std::move(base), std::move(exponent));
+        return async_operation<bigint>(async_task<bigint>(work, std::move(token), std::move(progress)));
+    }
+
+    inline async_operation<bigint> bigint::co_factorial(bigint n, cancellation_token token, progress_callback progress) {
+        const auto work = std::bind(&bigint::factorial, std::move(n));
+        return async_operation<bigint>(async_task<bigint>(work, std::move(token), std::move(progress)));
+    }
+
+    inline async_operation<std::pair<bigint, bigint>> bigint::co_divmod(bigint numerator, bigint denominator,
+                                                                        cancellation_token token,
+                                                                        progress_callback progress) {
+        const auto work = std::bind(&bigint::divmod, std::move(numerator), std::move(denominator));
+        return async_operation<std::pair<bigint, bigint>>(
+            async_task<std::pair<bigint, bigint>>(work, std::move(token), std::move(progress)));
+    }
+#endif
+
+    inline bigint bigint::double_factorial(const bigint& input) {
+        if (is_negative(input)) {
+            throw std::domain_error("Double factorial of Negative Integer is not defined.");
+        }
+        const std::uint64_t n = to_uint64(input, "Double factorial argument is too large.");
+        if (n < 2)
+            return 1;
+
+        return progression_product(n % 2 == 0 ? 2 : 3, n, 2);
+    }
+
+    inline bigint bigint::primorial(const bigint& input) {
+        if (input < 2)
+            return 1;
+        const std::uint64_t n = to_uint64(input, "Primorial argument is too large.");
+        if (n >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::domain_error("Primorial argument is too large.");
+        }
+
+        const auto primes = sieve_primes(static_cast<std::uint32_t>(n + 1));
+        return product(primes.begin(), primes.end());
+    }
+
+    inline std::pair<bigint, bigint> bigint::fibonacci_lucas(const bigint& n) {
+        // Start from (F(0), L(0)) and walk the bits of n from the top:
+        // F(2k) = F(k) L(k), L(2k) = L(k)^2 - 2 (-1)^k, F(2k+1) = (F(2k) + L(2k)) / 2, L(2k+1) = (5 F(2k) + L(2k)) / 2
+        bigint f = 0, l = 2;
+        bool odd = false;
+        const auto bits = to_words(n.vec);
+        for (std::size_t i = bits.size(); i-- > 0;) {
+            for (int bit = 31; bit >= 0; --bit) {
+                bigint f2 = f * l;
+                bigint l2 = l * l;
+                l2 += odd ? 2 : -2;
+                odd = false;
+                if ((bits[i] >> bit) & 1) {
+                    bigint f_next = (f2 + l2) >> 1;
+                    l2 = (f2 * 5 + l2) >> 1;
+                    f2 = std::move(f_next);
+                    odd = true;
+                }
+                f = std::move(f2);
+                l = std::move(l2);
+            }
+        }
+        return {f, l};
+    }
+
+    inline bigint bigint::fibonacci(const bigint& n) {
+        // F(-n) = (-1)^(n+1) F(n)
+        bigint result = fibonacci_lucas(abs(n)).first;
+        if (is_negative(n) && is_even(n)) result = -result;
+        return result;
+    }
+
+    inline bigint bigint::lucas(const bigint& n) {
+        // L(-n) = (-1)^n L(n)
+        bigint result = fibonacci_lucas(abs(n)).second;
+        if (is_negative(n) && !is_even(n)) result = -result;
+        return result;
+    }
+
+    inline std::array<bigint, 4> bigint::matrix_pow(const std::array<bigint, 4>& matrix, const bigint& exponent) {
+        if (is_negative(exponent)) {
+            throw std::domain_error("Negative matrix exponent is not supported.");
+        }
+        const auto multiplied = [](const std::array<bigint, 4>& x, const std::array<bigint, 4>& y) {
+            return std::array<bigint, 4>{{x[0] * y[0] + x[1] * y[2], x[0] * y[1] + x[1] * y[3],
+                                          x[2] * y[0] + x[3] * y[2], x[2] * y[1] + x[3] * y[3]}};
+        };
+        // [a b; c d]^2 = [a^2 + bc, b(a + d); c(a + d), d^2 + bc] in five multiplications
+        const auto squared = [](const std::array<bigint, 4>& x) {
+            const bigint bc = x[1] * x[2];
+            const bigint trace = x[0] + x[3];
+            return std::array<bigint, 4>{{x[0] * x[0] + bc, x[1] * trace, x[2] * trace, x[3] * x[3] + bc}};
+        };
+
+        std::array<bigint, 4> result{{1, 0, 0, 1}};
+        const auto bits = to_words(exponent.vec);
+        for (std::size_t i = bits.size(); i-- > 0;) {
+            for (int bit = 31; bit >= 0; --bit) {
+                result = squared(result);
+                if ((bits[i] >> bit) & 1) {
+                    result = multiplied(result, matrix);
+                }
+            }
+        }
+        return result;
+    }
+
+    inline bigint bigint::linear_recurrence(const bigint& p, const bigint& q, const bigint& a0, const bigint& a1, const bigint& n) {
+        // [a(k+1); a(k)] = [p q; 1 0]^k [a(1); a(0)]
+        const auto power = matrix_pow({{p, q, 1, 0}}, n);
+        return power[2] * a1 + power[3] * a0;
+    }
+
+    inline bigint bigint::binomial(const bigint& n, const bigint& k) {
+        if (is_negative(n) || is_negative(k)) {
+            throw std::domain_error("Binomial coefficient of Negative Integer is not defined.");
+        }
+        if (k > n) return 0;
+
+        // C(n, k) = n (n - 1) ... (n - k + 1) / k!, with the smaller of k and n - k
+        const bigint other = n - k;
+        const std::uint64_t terms = to_uint64(minimum(k, other), "Binomial coefficient argument is too large.");
+        if (terms == 0) return 1;
+
+        bigint numerator;
+        if (n.vec.size() <= 2) {
+            const std::uint64_t top = to_uint64(n, "");
+            numerator = progression_product(top - terms + 1, top, 1);
+        }
+        else {
+            std::vector<bigint> factors;
+            factors.reserve(terms);
+            for (bigint factor = n - terms + 1; factor <= n; ++factor) {
+                factors.push_back(factor);
+            }
+            numerator = product(factors.begin(), factors.end());
+        }
+        return numerator / progression_product(1, terms, 1);
+    }
+
+    /*
+     * Arithmetic modulo an odd modulus coprime to 10, kept in Montgomery form x * R mod n with R = 10^(9k).
+     * Values are little-endian base 10^9 limbs of exactly k limbs, reduced into [0, n).
+     */
+    class bigint::montgomery
+    {
+    public:
+        using limbs = std::vector<std::uint64_t>;
+
+        explicit montgomery(const bigint& modulus) : value(abs(modulus)), n(modulus.vec.rbegin(), modulus.vec.rend()) {
+            // -n^-1 mod 10^9 by Newton iteration; each step doubles the number of correct low digits.
+            // n is coprime to 10, so n^3 is its inverse modulo 10 to start from.
+            const std::uint64_t base = MAX_SIZE;
+            std::uint64_t inverse = (n[0] % 10) * (n[0] % 10) * (n[0] % 10) % 10;
+            for (int i = 0; i < 4; ++i) {
+                inverse = inverse * (2 + base - n[0] * inverse % base) % base;
+            }
+            n_prime = (base - inverse) % base;
+
+            std::vector<long long> r_squared(2 * n.size() + 1, 0);
+            r_squared.front() = 1;
+            r2 = to_limbs(bigint(std::move(r_squared)) % value);
+            one = reduce(r2);
+        }
+
+        const bigint& modulus() const { return value; }
+
+        limbs to_montgomery(const bigint& input) const {
+            bigint reduced = input % value;
+            if (is_negative(reduced)) reduced += value;
+            return multiply(to_limbs(reduced), r2);
+        }
+
+        bigint from_montgomery(const limbs& input) const {
+            const limbs plain = reduce(input);
+            std::vector<long long> result(plain.rbegin(), plain.rend());
+            return trim(bigint(std::move(result)));
+        }
+
+        const limbs& unity() const { return one; }
+
+        // CIOS Montgomery multiplication: a * b / R mod n
+        limbs multiply(const limbs& a, const limbs& b) const {
+            const std::size_t k = n.size();
+            const std::uint64_t base = MAX_SIZE;
+            limbs t(k + 2, 0);
+            for (std::size_t i = 0; i < k; ++i) {
+                std::uint64_t carry = 0;
+                for (std::size_t j = 0; j < k; ++j) {
+                    const std::uint64_t val = t[j] + a[i] * b[j] + carry;
+                    t[j] = val % base;
+                    carry = val / base;
+                }
+                std::uint64_t val = t[k] + carry;
+                t[k] = val % base;
+                t[k + 1] = val / base;
+
+                const std::uint64_t m = t[0] * n_prime % base;
+                carry = (t[0] + m * n[0]) / base;
+                for (std::size_t j = 1; j < k; ++j) {
+                    val = t[j] + m * n[j] + carry;
+                    t[j - 1] = val % base;
+                    carry = val / base;
+                }
+                val = t[k] + carry;
+                t[k - 1] = val % base;
+                t[k] = t[k + 1] + val / base;
+                t[k + 1] = 0;
+            }
+            if (t[k] != 0 || !less_than_modulus(t)) {
+                subtract_modulus(t);
+            }
+            t.resize(k);
+            return t;
+        }
+
+        limbs square(const limbs& a) const {
+            return multiply(a, a);
+        }
+
+        limbs add(limbs a, const limbs& b) const {
+            const std::uint64_t base = MAX_SIZE;
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                a[i] += b[i] + carry;
+                carry = a[i] >= base;
+                if (carry) a[i] -= base;
+            }
+            a.push_back(carry);
+            if (carry != 0 || !less_than_modulus(a)) {
+                subtract_modulus(a);
+            }
+            a.pop_back();
+            return a;
+        }
+
+        limbs subtract(limbs a, const limbs& b) const {
+            const std::uint64_t base = MAX_SIZE;
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                const std::uint64_t sub = b[i] + borrow;
+                borrow = a[i] < sub;
+                a[i] = a[i] + (borrow ? base : 0) - sub;
+            }
+            if (borrow != 0) {
+                std::uint64_t carry = 0;
+                for (std::size_t i = 0; i < a.size(); ++i) {
+                    a[i] += n[i] + carry;
+                    carry = a[i] >= base;
+                    if (carry) a[i] -= base;
+                }
+            }
+            return a;
+        }
+
+        // a / 2 mod n, valid in Montgomery form since halving commutes with the factor R
+        limbs halve(limbs a) const {
+            if (a[0] & 1) {
+                a.push_back(0);
+                const std::uint64_t base = MAX_SIZE;
+                std::uint64_t carry = 0;
+                for (std::size_t i = 0; i < n.size(); ++i) {
+                    a[i] += n[i] + carry;
+                    carry = a[i] >= base;
+                    if (carry) a[i] -= base;
+                }
+                a.back() = carry;
+            }
+            std::uint64_t remainder = 0;
+            for (std::size_t i = a.size(); i-- > 0;) {
+                const std::uint64_t val = remainder * MAX_SIZE + a[i];
+                a[i] = val / 2;
+                remainder = val % 2;
+            }
+            a.resize(n.size());
+            return a;
+        }
+
+        limbs pow(const limbs& base, const bigint& exponent) const {
+            const auto bits = to_words(exponent.vec);
+            limbs result = one;
+            for (std::size_t i = bits.size(); i-- > 0;) {
+                for (int bit = 31; bit >= 0; --bit) {
+                    result = square(result);
+                    if ((bits[i] >> bit) & 1) {
+                        result = multiply(result, base);
+                    }
+                }
+            }
+            return result;
+        }
+
+        static bool is_zero(const limbs& a) {
+            return std::all_of(a.begin(), a.end(), [](const std::uint64_t x) { return x == 0; });
+        }
+
+        // Value of the raw limbs; x * R shares its gcd with n with x, since R is coprime to n
+        static bigint raw(const limbs& input) {
+            std::vector<long long> result(input.rbegin(), input.rend());
+            return trim(bigint(std::move(result)));
+        }
+
+    private:
+        bigint value;
+        limbs n;
+        limbs r2;
+        limbs one;
+        std::uint64_t n_prime{};
+
+        limbs to_limbs(const bigint& input) const {
+            limbs result(input.vec.rbegin(), input.vec.rend());
+            result.resize(n.size(), 0);
+            return result;
+        }
+
+        limbs reduce(const limbs& input) const {
+            limbs unit(n.size(), 0);
+            unit[0] = 1;
+            return multiply(input, unit);
+        }
+
+        // Compares the low n.size() limbs, callers handle any higher limbs
+        bool less_than_modulus(const limbs& a) const {
+            for (std::size_t i = n.size(); i-- > 0;) {
+                if (a[i] != n[i]) return a[i] < n[i];
+            }
+            return false;
+        }
+
+        void subtract_modulus(limbs& a) const {
+            const std::uint64_t base = MAX_SIZE;
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < n.size(); ++i) {
+                const std::uint64_t sub = n[i] + borrow;
+                borrow = a[i] < sub;
+                a[i] = a[i] + (borrow ? base : 0) - sub;
+            }
+            for (std::size_t i = n.size(); borrow != 0 && i < a.size(); ++i) {
+                borrow = a[i] == 0;
+                a[i] = borrow ? base - 1 : a[i] - 1;
+            }
+        }
+    };
+
+    inline std::vector<std::uint32_t> bigint::sieve_primes(const std::uint32_t limit) {
+        std::vector<bool> composite(limit, false);
+        std::vector<std::uint32_t> result;
+        for (std::uint32_t i = 2; i < limit; ++i) {
+            if (composite[i]) continue;
+            result.push_back(i);
+            for (std::uint64_t j = static_cast<std::uint64_t>(i) * i; j < limit; j += i) {
+                composite[j] = true;
+            }
+        }
+        return result;
+    }
+
+    inline const std::vector<std::uint32_t>& bigint::small_primes() {
+        static const std::vector<std::uint32_t> primes = sieve_primes(SMALL_PRIME_LIMIT);
+        return primes;
+    }
+
+    inline bool bigint::strong_probable_prime(const montgomery& context, const bigint& base) {
+        const bigint n_minus_one = context.modulus() - 1;
+        const std::size_t s = trailing_zeros(n_minus_one);
+        const bigint d = n_minus_one >> s;
+
+        const auto minus_one = context.to_montgomery(n_minus_one);
+        auto x = context.pow(context.to_montgomery(base), d);
+        if (x == context.unity() || x == minus_one) {
+            return true;
+        }
+        for (std::size_t r = 1; r < s; ++r) {
+            x = context.square(x);
+            if (x == minus_one) return true;
+            if (x == context.unity()) return false;
+        }
+        return false;
+    }
+
+    // Strong Lucas test with Selfridge's parameters: the first D in 5, -7, 9, -11, ... with (D/n) = -1, P = 1, Q = (1 - D) / 4
+    inline bool bigint::strong_lucas_probable_prime(const montgomery& context) {
+        const bigint& n = context.modulus();
+
+        // Jacobi symbol (a / m) for small odd m > 0
+        const auto jacobi = [](std::uint64_t a, std::uint64_t m) {
+            int result = 1;
+            a %= m;
+            while (a != 0) {
+                while ((a & 1) == 0) {
+                    a >>= 1;
+                    if (m % 8 == 3 || m % 8 == 5) result = -result;
+                }
+                std::swap(a, m);
+                if (a % 4 == 3 && m % 4 == 3) result = -result;
+                a %= m;
+            }
+            return m == 1 ? result : 0;
+        };
+
+        // 10^9 is a multiple of 4, so the lowest limb gives n mod 4
+        const bool n_is_1_mod_4 = n.vec.back() % 4 == 1;
+        long long D = 5;
+        for (int attempt = 0;; ++attempt) {
+            const std::uint64_t magnitude = static_cast<std::uint64_t>(D < 0 ? -D : D);
+            // Quadratic reciprocity: (|D| / n) = (n / |D|) unless both are 3 mod 4
+            int symbol = jacobi(mod_small(n, static_cast<std::uint32_t>(magnitude)), magnitude);
+            if (magnitude % 4 == 3 && !n_is_1_mod_4) symbol = -symbol;
+            if (D < 0 && !n_is_1_mod_4) symbol = -symbol;
+
+            if (symbol == -1) break;
+            // n shares a factor with D
+            if (symbol == 0 && n != magnitude) return false;
+            // Perfect squares never yield -1, so rule them out once the search runs long
+            if (attempt == 10) {
+                const bigint root = sqrt(n);
+                if (root * root == n) return false;
+            }
+            D = D < 0 ? -D + 2 : -(D + 2);
+        }
+
+        const bigint Q = bigint(1 - D) / 4;
+        const auto q = context.to_montgomery(Q);
+        const auto d_mont = context.to_montgomery(D);
+
+        const bigint n_plus_one = n + 1;
+        const std::size_t s = trailing_zeros(n_plus_one);
+        const bigint d = n_plus_one >> s;
+        const auto bits = to_words(d.vec);
+
+        // U_1 = 1, V_1 = P = 1, Q^1
+        auto U = context.unity();
+        auto V = context.unity();
+        auto Qk = q;
+
+        std::size_t top_bit = 31;
+        while (((bits.back() >> top_bit) & 1) == 0) --top_bit;
+        for (std::size_t i = bits.size(); i-- > 0;) {
+            for (std::size_t bit = i + 1 == bits.size() ? top_bit : 32; bit-- > 0;) {
+                // Doubling: U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+                U = context.multiply(U, V);
+                V = context.subtract(context.square(V), context.add(Qk, Qk));
+                Qk = context.square(Qk);
+                if ((bits[i] >> bit) & 1) {
+                    // Increment with P = 1: U_k+1 = (U_k + V_k) / 2, V_k+1 = (D U_k + V_k) / 2
+                    auto next_U = context.halve(context.add(U, V));
+                    V = context.halve(context.add(context.multiply(d_mont, U), V));
+                    U = std::move(next_U);
+                    Qk = context.multiply(Qk, q);
+                }
+            }
+        }
+
+        if (montgomery::is_zero(U) || montgomery::is_zero(V)) return true;
+        for (std::size_t r = 1; r < s; ++r) {
+            V = context.subtract(context.square(V), context.add(Qk, Qk));
+            if (montgomery::is_zero(V)) return true;
+            Qk = context.square(Qk);
+        }
+        return false;
+    }
+
+    inline bool bigint::is_prime(const bigint& input, const int rounds) {
+        if (is_negative(input) || input < 2)
+            return false;
+
+        const auto& primes = small_primes();
+        for (const auto p : primes) {
+            if (mod_small(input, p) == 0) {
+                return input == p;
+            }
+        }
+        // No factor below the limit, so anything below its square is prime
+        if (input < static_cast<long long>(SMALL_PRIME_LIMIT) * SMALL_PRIME_LIMIT) {
+            return true;
+        }
+
+        return baillie_psw(input, rounds);
+    }
+
+    inline bool bigint::baillie_psw(const bigint& input, const int rounds) {
+        const auto& primes = small_primes();
+        const montgomery context(input);
+        if (!strong_probable_prime(context, 2)) return false;
+        if (!strong_lucas_probable_prime(context)) return false;
+        for (int i = 0; i < rounds && i + 1 < static_cast<int>(primes.size()); ++i) {
+            if (!strong_probable_prime(context, primes[i + 1])) return false;
+        }
+        return true;
+    }
+
+    // First prime strictly above (or below) start, which must be at least SMALL_PRIME_LIMIT
+    inline bigint bigint::sieve_search(const bigint& start, const bool upward, std::size_t threads) {
+        constexpr std::size_t window = 4096;
+        const auto& primes = small_primes();
+        if (threads == 0) threads = thread_pool::instance().size() + 1;
+
+        // Odd candidates base, base +- 2, base +- 4, ...
+        bigint base = upward ? start + 1 : start - 1;
+        if (is_even(base)) base += upward ? 1 : -1;
+
+        // Residues of base modulo each odd small prime, advanced with machine arithmetic between windows
+        std::vector<std::uint32_t> residues(primes.size());
+        for (std::size_t i = 1; i < primes.size(); ++i) {
+            residues[i] = mod_small(base, primes[i]);
+        }
+
+        std::vector<bool> composite(window);
+        std::vector<std::size_t> survivors;
+        survivors.reserve(window);
+        for (;;) {
+            std::fill(composite.begin(), composite.end(), false);
+            for (std::size_t i = 1; i < primes.size(); ++i) {
+                const std::uint64_t p = primes[i];
+                const std::uint64_t half = (p + 1) / 2;
+                // Offset k with base +- 2k == 0 (mod p)
+                const std::uint64_t r = residues[i];
+                std::uint64_t k = upward ? (p - r) % p * half % p : r * half % p;
+                for (; k < window; k += p) {
+                    composite[k] = true;
+                }
+                residues[i] = static_cast<std::uint32_t>(upward ? (r + 2 * window) % p : (r + p - 2 * window % p) % p);
+            }
+
+            survivors.clear();
+            for (std::size_t k = 0; k < window; ++k) {
+                if (!composite[k]) survivors.push_back(k);
+            }
+
+            // Test survivors in batches of `threads`, keeping the nearest prime in each batch
+            for (std::size_t first = 0; first < survivors.size(); first += threads) {
+                const std::size_t batch = std::min(threads, survivors.size() - first);
+                std::vector<char> found(batch, 0);
+                const auto test = [&](const std::size_t i) {
+                    const long long offset = 2 * static_cast<long long>(survivors[first + i]);
+                    found[i] = baillie_psw(upward ? base + offset : base - offset, 0);
+                };
+                if (batch == 1) {
+                    test(0);
+                }
+                else {
+                    thread_pool::instance().parallel_for(batch, test, batch);
+                }
+                for (std::size_t i = 0; i < batch; ++i) {
+                    if (found[i]) {
+                        const long long offset = 2 * static_cast<long long>(survivors[first + i]);
+                        return upward ? base + offset : base - offset;
+                    }
+                }
+            }
+
+            const long long step = 2 * static_cast<long long>(window);
+            base += upward ? step : -step;
+        }
+    }
+
+    inline bigint bigint::next_prime(const bigint& n, const std::size_t threads) {
+        if (n < SMALL_PRIME_LIMIT) {
+            const auto& primes = small_primes();
+            const auto it = std::upper_bound(primes.begin(), primes.end(), n < 0 ? 0 : static_cast<std::uint32_t>(static_cast<long long>(n)));
+            if (it != primes.end()) return *it;
+        }
+        return sieve_search(maximum(n, SMALL_PRIME_LIMIT), true, threads);
+    }
+
+    inline bigint bigint::prev_prime(const bigint& n, const std::size_t threads) {
+        if (n <= 2) {
+            throw std::domain_error("There is no prime below 2.");
+        }
+        // The sieve needs every candidate above the small primes it divides by
+        if (n <= static_cast<long long>(SMALL_PRIME_LIMIT) * 2 + 4096 * 2) {
+            for (bigint candidate = n - 1;; --candidate) {
+                if (is_prime(candidate)) return candidate;
+            }
+        }
+        return sieve_search(n, false, threads);
+    }
+
+    // Brent's variant of Pollard's rho with f(x) = x^2 + c, batching gcds over products of differences
+    inline bigint bigint::pollard_brent(const montgomery& context, const std::uint64_t c, const std::size_t max_iterations) {
+        const bigint& n = context.modulus();
+        constexpr std::size_t batch = 128;
+        const auto c_mont = context.to_montgomery(c);
+        const auto f = [&](const montgomery::limbs& x) { return context.add(context.square(x), c_mont); };
+
+        auto y = context.to_montgomery(2);
+        auto x = y, saved = y;
+        auto q = context.unity();
+        bigint g = 1;
+        for (std::size_t r = 1; g == 1 && r <= max_iterations; r *= 2) {
+            x = y;
+            for (std::size_t i = 0; i < r; ++i) {
+                y = f(y);
+            }
+            for (std::size_t k = 0; k < r && g == 1; k += batch) {
+                saved = y;
+                for (std::size_t i = 0; i < std::min(batch, r - k); ++i) {
+                    y = f(y);
+                    q = context.multiply(q, context.subtract(x, y));
+                }
+                g = gcd(montgomery::raw(q), n);
+            }
+        }
+
+        // The batch overshot to a multiple of n, redo it one step at a time
+        if (g == n) {
+            do {
+                saved = f(saved);
+                g = gcd(montgomery::raw(context.subtract(x, saved)), n);
+            } while (g == 1);
+        }
+        return g == 1 || g == n ? bigint(0) : g;
+    }
+
+    /*
+     * Lenstra's elliptic curve method on a Montgomery curve with Suyama's parametrization.
+     * Stage 1 multiplies by every prime power up to bound, stage 2 catches one extra prime up to 100 * bound
+     * with Montgomery's standard continuation. prime_flags must cover 100 * bound + STEP.
+     */
+    inline bigint bigint::ecm_curve(const montgomery& context, const std::vector<std::uint32_t>& primes,
+                                    const std::vector<bool>& prime_flags, const std::uint64_t sigma, const std::uint32_t bound) {
+        using limbs = montgomery::limbs;
+        const bigint& n = context.modulus();
+
+        const auto u = context.subtract(context.to_montgomery(sigma * sigma), context.to_montgomery(5));
+        const auto v = context.to_montgomery(4 * sigma);
+        const auto u3 = context.multiply(context.square(u), u);
+        const auto v_minus_u = context.subtract(v, u);
+        const auto three_u_plus_v = context.add(context.add(context.add(u, u), u), v);
+
+        // a24 = (A + 2) / 4 = (v - u)^3 (3u + v) / (16 u^3 v)
+        const auto numerator = context.multiply(context.multiply(context.square(v_minus_u), v_minus_u), three_u_plus_v);
+        const bigint denominator = context.from_montgomery(context.multiply(context.multiply(u3, v), context.to_montgomery(16)));
+        const bigint g = gcd(denominator, n);
+        if (g != 1) {
+            return g == n ? bigint(0) : g;
+        }
+        const auto a24 = context.multiply(numerator, context.to_montgomery(modinv(denominator, n)));
+
+        struct point
+        {
+            limbs x, z;
+        };
+        const auto doubled = [&](const point& p) {
+            const auto sum = context.square(context.add(p.x, p.z));
+            const auto diff = context.square(context.subtract(p.x, p.z));
+            const auto cross = context.subtract(sum, diff);
+            return point{context.multiply(sum, diff), context.multiply(cross, context.add(diff, context.multiply(a24, cross)))};
+        };
+        const auto added = [&](const point& p, const point& q, const point& difference) {
+            const auto a = context.multiply(context.subtract(p.x, p.z), context.add(q.x, q.z));
+            const auto b = context.multiply(context.add(p.x, p.z), context.subtract(q.x, q.z));
+            return point{context.multiply(difference.z, context.square(context.add(a, b))),
+                         context.multiply(difference.x, context.square(context.subtract(a, b)))};
+        };
+        // Montgomery ladder for a small scalar
+        const auto scaled = [&](const point& p, const std::uint64_t k) {
+            point low = p, high = doubled(p);
+            int bit = 63;
+            while (((k >> bit) & 1) == 0) --bit;
+            for (--bit; bit >= 0; --bit) {
+                if ((k >> bit) & 1) {
+                    low = added(high, low, p);
+                    high = doubled(high);
+                }
+                else {
+                    high = added(low, high, p);
+                    low = doubled(low);
+                }
+            }
+            return low;
+        };
+
+        point q{u3, context.multiply(context.square(v), v)};
+        for (const auto p : primes) {
+            if (p > bound) break;
+            for (std::uint64_t power = p; power <= bound; power *= p) {
+                q = scaled(q, p);
+            }
+        }
+
+        bigint factor = gcd(montgomery::raw(q.z), n);
+        if (factor == n) return 0;
+        if (factor != 1) return factor;
+
+        // Stage 2: a prime p = m * STEP +- j has [m * STEP]Q == -+[j]Q modulo the hidden factor,
+        // so the x-coordinates agree projectively and the cross product X_m Z_j - X_j Z_m vanishes
+        constexpr std::uint32_t STEP = 210;
+        const std::uint64_t limit = 100ULL * bound;
+        std::vector<std::uint32_t> offsets;
+        std::vector<point> baby;
+        point odd = q;
+        const point two_q = doubled(q);
+        // [-1]Q shares its x-coordinate with Q, so Q also serves as the difference for [3]Q = Q + [2]Q
+        point previous_odd = q;
+        for (std::uint32_t j = 1; j < STEP / 2; j += 2) {
+            if (j > 1) {
+                const point next = added(odd, two_q, previous_odd);
+                previous_odd = odd;
+                odd = next;
+            }
+            if (j % 3 != 0 && j % 5 != 0 && j % 7 != 0) {
+                offsets.push_back(j);
+                baby.push_back(odd);
+            }
+        }
+
+        const point step = scaled(q, STEP);
+        const std::uint64_t first = bound / STEP + 1;
+        point giant = scaled(q, first * STEP);
+        point giant_previous = scaled(q, (first - 1) * STEP);
+        auto product = context.unity();
+        for (std::uint64_t m = first; (m - 1) * STEP <= limit; ++m) {
+            const std::uint64_t center = m * STEP;
+            for (std::size_t i = 0; i < offsets.size(); ++i) {
+                const std::uint64_t above = center + offsets[i], below = center - offsets[i];
+                if ((above <= limit && prime_flags[above]) || (below > bound && below <= limit && prime_flags[below])) {
+                    product = context.multiply(product, context.subtract(context.multiply(giant.x, baby[i].z),
+                                                                         context.multiply(baby[i].x, giant.z)));
+                }
+            }
+            const point next = added(giant, step, giant_previous);
+            giant_previous = giant;
+            giant = next;
+        }
+
+        factor = gcd(montgomery::raw(product), n);
+        return factor == 1 || factor == n ? bigint(0) : factor;
+    }
+
+    inline bigint bigint::find_factor(const bigint& n, std::size_t threads) {
+        const bigint root = sqrt(n);
+        if (root * root == n) return root;
+
+        const montgomery context(n);
+        for (std::uint64_t c = 1; c <= 2; ++c) {
+            bigint factor = pollard_brent(context, c, 1 << 18);
+            if (factor != 0) return factor;
+        }
+
+        // Bounds and curve counts tuned for factors of roughly 15, 20 and 25 digits; the last level repeats
+        static const std::pair<std::uint32_t, std::size_t> levels[] = {{2000, 25}, {11000, 90}, {50000, 300}, {250000, 700}};
+        if (threads == 0) threads = thread_pool::instance().size() + 1;
+
+        std::vector<std::uint32_t> primes;
+        std::vector<bool> prime_flags;
+        std::uint64_t sigma = 6;
+        for (std::size_t level = 0;; level = std::min<std::size_t>(level + 1, 3)) {
+            const std::uint32_t bound = levels[level].first;
+            // Stage 2 reaches 100 * bound, plus one giant step
+            if (prime_flags.size() < 100 * bound + 256) {
+                primes = sieve_primes(100 * bound + 256);
+                prime_flags.assign(100 * bound + 256, false);
+                for (const auto p : primes) {
+                    prime_flags[p] = true;
+                }
+            }
+            for (std::size_t curves = 0; curves < levels[level].second; curves += threads) {
+                const std::size_t batch = std::min(threads, levels[level].second - curves);
+                std::vector<bigint> found(batch, 0);
+                const std::uint64_t first_sigma = sigma;
+                sigma += batch;
+                thread_pool::instance().parallel_for(batch, [&](const std::size_t i) {
+                    found[i] = ecm_curve(context, primes, prime_flags, first_sigma + i, bound);
+                }, batch);
+                for (const auto& factor : found) {
+                    if (factor != 0) return factor;
+                }
+            }
+        }
+    }
+
+    inline std::vector<std::pair<bigint, std::size_t>> bigint::factorize(const bigint& n, const std::size_t threads) {
+        if (n == 0) {
+            throw std::domain_error("Zero has no prime factorization.");
+        }
+
+        std::map<bigint, std::size_t> factors;
+        bigint rest = abs(n);
+        for (const auto p : small_primes()) {
+            while (mod_small(rest, p) == 0) {
+                rest /= p;
+                ++factors[p];
+            }
+        }
+
+        std::vector<bigint> pending;
+        if (rest != 1) pending.push_back(rest);
+        while (!pending.empty()) {
+            const bigint value = pending.back();
+            pending.pop_back();
+            if (is_prime(value)) {
+                ++factors[value];
+                continue;
+            }
+            const bigint factor = find_factor(value, threads);
+            pending.push_back(factor);
+            pending.push_back(value / factor);
+        }
+
+        return {factors.begin(), factors.end()};
+    }
+
+    inline bigint bigint::random_prime(const std::size_t bits, const std::size_t threads) {
+        if (bits < 2) {
+            throw std::domain_error("A prime needs at least 2 bits.");
+        }
+        const bigint low = bigint(1) << (bits - 1);
+        const bigint high = bigint(1) << bits;
+        auto& engine = default_engine();
+        for (;;) {
+            // Random value in [2^(bits-1), 2^bits)
+            const bigint start = random_bits(bits - 1, engine) + low;
+
+            const bigint candidate = next_prime(start - 1, threads);
+            if (candidate < high) return candidate;
+        }
+    }
+
+    inline bigint bigint::random(const size_t length) {
+        return random_digits(length);
+    }
+
+    template <typename Engine>
+    bigint bigint::random_bits(const std::size_t bits, Engine& engine) {
+        std::uniform_int_distribution<std::uint64_t> draw;
+        std::vector<std::uint32_t> words((bits + 31) / 32);
+        for (std::size_t i = 0; i < words.size(); i += 2) {
+            const std::uint64_t value = draw(engine);
+            words[i] = static_cast<std::uint32_t>(value);
+            if (i + 1 < words.size()) words[i + 1] = static_cast<std::uint32_t>(value >> 32);
+        }
+        if (bits % 32 != 0) {
+            words.back() &= (std::uint32_t{1} << (bits % 32)) - 1;
+        }
+        return bigint(from_words(words));
+    }
+
+    template <typename Engine>
+    bigint bigint::random_digits(const std::size_t digits, Engine& engine) {
+        if (digits == 0) {
+            throw std::domain_error("A random number needs at least one digit.");
+        }
+        // The top limb holds the leftover 1 to 9 digits and may not start with a zero
+        std::vector<long long> limbs((digits + 8) / 9);
+        long long top_low = 1;
+        for (std::size_t i = 1; i < digits - 9 * (limbs.size() - 1); ++i) top_low *= 10;
+        limbs.front() = std::uniform_int_distribution<long long>(top_low, top_low * 10 - 1)(engine);
+
+        std::uniform_int_distribution<long long> limb(0, MAX_SIZE - 1);
+        for (std::size_t i = 1; i < limbs.size(); ++i) limbs[i] = limb(engine);
+        return bigint(std::move(limbs));
+    }
+
+    template <typename Engine>
+    bigint bigint::random_below(const bigint& bound, Engine& engine) {
+        if (bound <= 0) {
+            throw std::domain_error("Random bound must be positive.");
+        }
+        // Rejection sampling over [0, (top + 1) * MAX_SIZE^(n-1)), decided as soon as a limb leaves the prefix of bound
+        const auto& b = bound.vec;
+        std::vector<long long> limbs(b.size());
+        std::uniform_int_distribution<long long> top(0, b.front()), limb(0, MAX_SIZE - 1);
+        for (;;) {
+            limbs.front() = top(engine);
+            bool equal = limbs.front() == b.front(), rejected = false;
+            for (std::size_t i = 1; i < limbs.size(); ++i) {
+                limbs[i] = limb(engine);
+                if (equal) {
+                    rejected = limbs[i] > b[i];
+                    if (rejected) break;
+                    equal = limbs[i] == b[i];
+                }
+            }
+            if (!rejected && !equal) break;
+        }
+
+        const auto first = std::find_if(limbs.begin(), limbs.end() - 1, [](const long long x) { return x != 0; });
+        limbs.erase(limbs.begin(), first);
+        return bigint(std::move(limbs));
+    }
+
+    inline bool bigint::parse_eight_digits(const char* digits, std::uint64_t& value) {
+        // Byte i of the word holds digit i, so the most significant digit sits in the lowest byte
+        std::uint64_t word = 0;
+        for (int i = 0; i < 8; ++i) {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(digits[i])) << (8 * i);
+        }
+
+        // Every byte must be 0x30 .. 0x39: high nibble 3, and adding 6 must not carry into it
+        const std::uint64_t high = word & 0xF0F0F0F0F0F0F0F0ULL;
+        const std::uint64_t carried = ((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4;
+        if ((high | carried) != 0x3333333333333333ULL) return false;
+
+        // Combine neighbouring digits, then pairs, then quads, with two multiplications
+        word -= 0x3030303030303030ULL;
+        word = word * 10 + (word >> 8);
+        word = ((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL +
+                ((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL) >> 32;
+        value = word;
+        return true;
+    }
+
+    inline std::vector<long long> bigint::decimal_to_vector(const char* first, const char* last) {
+        const auto length = static_cast<std::size_t>(last - first);
+        // Reject empty input and leading zeros
+        if (length == 0 || (length > 1 && *first == '0')) {
+            throw std::runtime_error("Invalid Big Integer.");
+        }
+
+        std::vector<long long> result;
+        result.reserve((length + 8) / 9);
+
+        // The leading limb takes the digits that do not fill a whole limb
+        const std::size_t head = length % 9 == 0 ? 9 : length % 9;
+        long long limb = 0;
+        for (const char* end = first + head; first != end; ++first) {
+            if (*first < '0' || *first > '9') throw std::runtime_error("Invalid Big Integer.");
+            limb = limb * 10 + (*first - '0');
+        }
+        result.push_back(limb);
+
+        for (; first != last; first += 9) {
+            std::uint64_t high;
+            if (!parse_eight_digits(first, high) || first[8] < '0' || first[8] > '9') {
+                throw std::runtime_error("Invalid Big Integer.");
+            }
+            result.push_back(static_cast<long long>(high * 10 + (first[8] - '0')));
+        }
+        return result;
+    }
+
+    inline std::vector<long long> bigint::power_of_two_to_vector(const char* first, const char* last, const int bits_per_digit) {
+        // Pack the digits straight into 32-bit words from the least significant end
+        const auto length = static_cast<std::size_t>(last - first);
+        std::vector<std::uint32_t> words;
+        words.reserve(length * bits_per_digit / 32 + 1);
+        std::uint64_t pending = 0;
+        int pending_bits = 0;
+        for (const char* it = last; it != first;) {
+            const int digit = digit_value(*--it);
+            if (digit >> bits_per_digit != 0) throw std::runtime_error("Invalid Big Integer.");
+
+            pending |= static_cast<std::uint64_t>(digit) << pending_bits;
+            pending_bits += bits_per_digit;
+            if (pending_bits >= 32) {
+                words.push_back(static_cast<std::uint32_t>(pending));
+                pending >>= 32;
+                pending_bits -= 32;
+            }
+        }
+        if (pending_bits > 0) words.push_back(static_cast<std::uint32_t>(pending));
+        while (!words.empty() && words.back() == 0) words.pop_back();
+        return from_words(words);
+    }
+
+    inline std::string bigint::to_power_of_two_string(const bigint& input, const int bits_per_digit, const char* prefix) {
+        static const char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        const auto words = to_words(input.vec);
+
+        std::string result = is_negative(input) ? "-" : "";
+        result += prefix;
+        if (words.empty()) return result + '0';
+
+        // Unpack bits_per_digit bits at a time from the least significant end, then reverse
+        const std::size_t start = result.size();
+        const std::uint32_t mask = (1U << bits_per_digit) - 1;
+        result.reserve(start + (words.size() * 32 + bits_per_digit - 1) / bits_per_digit);
+        std::uint64_t pending = 0;
+        int pending_bits = 0;
+        for (const auto word : words) {
+            pending |= static_cast<std::uint64_t>(word) << pending_bits;
+            pending_bits += 32;
+            for (; pending_bits >= bits_per_digit; pending_bits -= bits_per_digit, pending >>= bits_per_digit) {
+                result += digit_chars[pending & mask];
+            }
+        }
+        if (pending_bits > 0) result += digit_chars[pending & mask];
+        while (result.size() > start + 1 && result.back() == '0') result.pop_back();
+        std::reverse(result.begin() + static_cast<std::ptrdiff_t>(start), result.end());
+        return result;
+    }
+
+    inline std::string bigint::to_string(const bigint& value, const int base) {
+        if (base < 2 || base > 36) throw std::domain_error("Base must be between 2 and 36.");
+        if (base == 10) return std::string(value);
+        if ((base & (base - 1)) == 0) {
+            int bits = 0;
+            while ((1 << bits) < base) ++bits;
+            return to_power_of_two_string(value, bits, "");
+        }
+
+        // Largest power of the base that is still a single decimal limb
+        std::uint32_t chunk = static_cast<std::uint32_t>(base);
+        int per_chunk = 1;
+        while (static_cast<std::uint64_t>(chunk) * base < static_cast<std::uint64_t>(MAX_SIZE)) {
+            chunk *= base;
+            ++per_chunk;
+        }
+
+        std::vector<std::uint32_t> chunks;
+        std::vector<bigint> reciprocals;
+        to_chunks(abs(value), chunk, 0, reciprocals, chunks);
+        if (chunks.empty()) return "0";
+
+        static const char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        std::string result;
+        result.reserve(chunks.size() * per_chunk + 1);
+        for (const auto piece : chunks) {
+            std::uint32_t rest = piece;
+            for (int i = 0; i < per_chunk; ++i) {
+                result += digit_chars[rest % base];
+                rest /= base;
+            }
+        }
+        while (result.size() > 1 && result.back() == '0') result.pop_back();
+        if (is_negative(value)) result += '-';
+        std::reverse(result.begin(), result.end());
+        return result;
     }
 
-    inline bigint bigint::subtract(const bigint& lhs, const bigint& rhs) {
-        // Ensure LHS is larger than RHS, and both are positive
-        // (-A) - (-B) == B - A
-        if (is_negative(lhs) && is_negative(rhs)) {
-            return subtract(abs(rhs), abs(lhs));
+    inline void bigint::to_chunks(const bigint& value, const std::uint32_t chunk, const std::size_t count,
+                                  std::vector<bigint>& reciprocals, std::vector<std::uint32_t>& out) {
+        if (value.vec.size() <= CONVERSION_THRESHOLD) {
+            // Repeated short division of the limbs by chunk
+            std::vector<long long> rest = value.vec;
+            std::size_t emitted = 0;
+            while (rest.size() > 1 || rest.front() != 0) {
+                long long remainder = 0;
+                for (auto& limb : rest) {
+                    const long long current = remainder * MAX_SIZE + limb;
+                    limb = current / chunk;
+                    remainder = current % chunk;
+                }
+                if (rest.size() > 1 && rest.front() == 0) rest.erase(rest.begin());
+                out.push_back(static_cast<std::uint32_t>(remainder));
+                ++emitted;
+            }
+            for (; emitted < count; ++emitted) out.push_back(0);
+            return;
+        }
+
+        // Split around the largest cached power chunk^(2^k) with at most half the limbs of the value
+        std::size_t k = 0;
+        power_limbs power = square_power<decimal_radix>(chunk, 0);
+        for (;;) {
+            const auto next = square_power<decimal_radix>(chunk, k + 1, power);
+            if (next->size() > (value.vec.size() + 1) / 2) break;
+            power = next;
+            ++k;
+        }
+        const bigint divisor = from_limbs(*power);
+        if (reciprocals.size() <= k) reciprocals.resize(k + 1);
+        const bool newton = divisor.vec.size() >= RECIPROCAL_DIVISION_THRESHOLD;
+        if (newton && reciprocals[k] == 0) reciprocals[k] = reciprocal(divisor);
+        const auto split = newton ? divmod_reciprocal(value, divisor, reciprocals[k]) : divmod(value, divisor);
+        to_chunks(split.second, chunk, std::size_t{1} << k, reciprocals, out);
+        to_chunks(split.first, chunk, count == 0 ? 0 : count - (std::size_t{1} << k), reciprocals, out);
+    }
+
+    inline bigint bigint::shift_limbs(bigint value, const std::size_t count) {
+        if (value != 0) value.vec.insert(value.vec.end(), count, 0);
+        return value;
+    }
+
+    inline bigint bigint::drop_limbs(bigint value, const std::size_t count) {
+        if (count >= value.vec.size()) return 0;
+        value.vec.resize(value.vec.size() - count);
+        return value;
+    }
+
+    inline bigint bigint::reciprocal(const bigint& divisor) {
+        const std::size_t n = divisor.vec.size();
+        const bigint scale = shift_limbs(1, 2 * n);
+        if (n <= NEWTON_THRESHOLD) return divmod(scale, divisor).first;
+
+        // The reciprocal of the leading n / 2 + 2 limbs is good to about n / 2 limbs, one Newton step doubles that
+        const std::size_t h = n / 2 + 2;
+        const bigint top(std::vector<long long>(divisor.vec.begin(), divisor.vec.begin() + static_cast<std::ptrdiff_t>(h)));
+        bigint estimate = shift_limbs(reciprocal(top), n - h);
+        const bigint error = scale - divisor * estimate;
+        estimate += drop_limbs(estimate * error, 2 * n);
+
+        // What is left is an error of a few units
+        bigint remainder = scale - divisor * estimate;
+        while (remainder < 0) {
+            estimate -= 1;
+            remainder += divisor;
+        }
+        while (remainder >= divisor) {
+            estimate += 1;
+            remainder -= divisor;
+        }
+        return estimate;
+    }
+
+    inline std::pair<bigint, bigint> bigint::divmod_reciprocal(const bigint& value, const bigint& divisor,
+                                                               const bigint& inverse) {
+        const std::size_t n = divisor.vec.size();
+        std::vector<long long> quotient;
+        quotient.reserve(value.vec.size());
+        bigint remainder;
+
+        // Every step divides remainder * MAX_SIZE^length + block < divisor * MAX_SIZE^n, whose quotient the
+        // reciprocal underestimates by at most two
+        const std::size_t first = value.vec.size() % n == 0 ? n : value.vec.size() % n;
+        for (std::size_t start = 0, length = first; start < value.vec.size(); start += length, length = n) {
+            const auto block = value.vec.begin() + static_cast<std::ptrdiff_t>(start);
+            std::vector<long long> limbs = remainder == 0 ? std::vector<long long>() : remainder.vec;
+            limbs.insert(limbs.end(), block, block + static_cast<std::ptrdiff_t>(length));
+            const bigint current = trim(bigint(std::move(limbs)));
+
+            bigint digit = drop_limbs(current * inverse, 2 * n);
+            remainder = current - digit * divisor;
+            while (remainder >= divisor) {
+                digit += 1;
+                remainder -= divisor;
+            }
+            quotient.insert(quotient.end(), length - digit.vec.size(), 0);
+            quotient.insert(quotient.end(), digit.vec.begin(), digit.vec.end());
+        }
+        return {trim(bigint(std::move(quotient))), remainder};
+    }
+
+    inline bigint bigint::from_string(const std::string& str, const int base) {
+        if (base < 2 || base > 36) throw std::domain_error("Base must be between 2 and 36.");
+        const char* first = str.data();
+        const char* const last = first + str.size();
+        const bool negative = first != last && *first == '-';
+        if (negative) ++first;
+        if (first == last) throw std::runtime_error("Invalid Big Integer.");
+
+        bigint result;
+        if ((base & (base - 1)) == 0) {
+            int bits = 0;
+            while ((1 << bits) < base) ++bits;
+            result.vec = power_of_two_to_vector(first, last, bits);
+        }
+        else {
+            // Group the digits into chunks that fit a decimal limb, least significant chunk first
+            std::uint64_t chunk = base;
+            std::size_t per_chunk = 1;
+            while (chunk * base < static_cast<std::uint64_t>(MAX_SIZE)) {
+                chunk *= base;
+                ++per_chunk;
+            }
+            const auto length = static_cast<std::size_t>(last - first);
+            std::vector<limb_t> chunks((length + per_chunk - 1) / per_chunk, 0);
+            for (std::size_t i = 0; i < length; ++i) {
+                const int digit = digit_value(first[i]);
+                if (digit >= base) throw std::runtime_error("Invalid Big Integer.");
+                const std::size_t position = length - 1 - i;
+                auto& piece = chunks[position / per_chunk];
+                piece = piece * base + digit;
+            }
+            const auto decimal = convert_radix<decimal_radix>(chunks.data(), chunks.size(), chunk);
+            result.vec = decimal.empty() ? std::vector<long long>{0} : std::vector<long long>(decimal.rbegin(), decimal.rend());
+        }
+
+        // Same rule as from_chars: zero has no sign
+        if (negative && result.vec.size() == 1 && result.vec.front() == 0) throw std::runtime_error("Invalid Big Integer.");
+        result.is_neg = negative;
+        return result;
+    }
+
+    inline std::string bigint::to_hex(const bigint& input) {
+        return to_power_of_two_string(input, 4, "0x");
+    }
+
+    inline std::string bigint::to_binary(const bigint& input) {
+        return to_power_of_two_string(input, 1, "0b");
+    }
+
+    inline void bigint::write_limb(char* out, std::uint32_t limb) {
+        static const char digit_pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        for (int i = 7; i > 0; i -= 2) {
+            std::memcpy(out + i, digit_pairs + 2 * (limb % 100), 2);
+            limb /= 100;
+        }
+        out[0] = static_cast<char>('0' + limb);
+    }
+
+    inline to_chars_result bigint::to_chars(char* first, char* last, const bigint& value, std::size_t threads) {
+        const std::size_t size = formatted_size(value);
+        if (static_cast<std::size_t>(last - first) < size) {
+            return {last, std::errc::value_too_large};
+        }
+
+        if (is_negative(value)) *first++ = '-';
+        // The leading limb is unpadded, every other limb takes exactly nine characters
+        char head[9];
+        write_limb(head, static_cast<std::uint32_t>(value.vec.front()));
+        const std::size_t head_size = decimal_digits(1, value.vec.front());
+        std::memcpy(first, head + 9 - head_size, head_size);
+        first += head_size;
+
+        const std::size_t limbs = value.vec.size() - 1;
+        const long long* tail = value.vec.data() + 1;
+        if (threads == 0) threads = thread_pool::instance().size() + 1;
+        const std::size_t chunks = std::min(threads, limbs / PARALLEL_FORMAT_THRESHOLD);
+        if (chunks > 1) {
+            thread_pool::instance().parallel_for(chunks, [&](const std::size_t chunk) {
+                const std::size_t begin = limbs * chunk / chunks, end = limbs * (chunk + 1) / chunks;
+                for (std::size_t i = begin; i < end; ++i) {
+                    write_limb(first + 9 * i, static_cast<std::uint32_t>(tail[i]));
+                }
+            }, chunks);
+        }
+        else {
+            for (std::size_t i = 0; i < limbs; ++i) {
+                write_limb(first + 9 * i, static_cast<std::uint32_t>(tail[i]));
+            }
+        }
+        return {first + 9 * limbs, std::errc()};
+    }
+
+    inline int bigint::count_digits(const bigint& input) {
+        return static_cast<int>(decimal_digits(input.vec.size(), input.vec.front()));
+    }
+
+    template <typename Radix>
+    std::vector<bigint::limb_t> bigint::convert_radix(const limb_t* d, const std::size_t n, const std::uint64_t from) {
+        std::vector<limb_t> result;
+        if (n <= CONVERSION_THRESHOLD) {
+            // Horner's scheme: result = result * from + digit
+            for (std::size_t i = n; i-- > 0;) {
+                limb_t carry = d[i];
+                for (auto& limb : result) {
+                    const limb_t val = limb * from + carry;
+                    limb = val % Radix::base();
+                    carry = val / Radix::base();
+                }
+                while (carry > 0) {
+                    result.push_back(carry % Radix::base());
+                    carry /= Radix::base();
+                }
+            }
+            return result;
+        }
+
+        // d = high * from^half + low with half the largest power of two below n
+        std::size_t k = 0;
+        while ((std::size_t{2} << k) < n) ++k;
+        const std::size_t half = std::size_t{1} << k;
+        auto low = convert_radix<Radix>(d, half, from);
+        const auto high = convert_radix<Radix>(d + half, n - half, from);
+        if (high.empty()) return low;
+
+        const auto power = square_power<Radix>(from, k);
+        result.resize(high.size() + power->size());
+        multiply_limbs<Radix>(high.data(), high.size(), power->data(), power->size(), result.data());
+        add_limbs<Radix>(result.data(), result.size(), low.data(), low.size());
+        while (!result.empty() && result.back() == 0) result.pop_back();
+        return result;
+    }
+
+    inline std::vector<std::uint32_t> bigint::to_words(const std::vector<long long>& input) {
+        const auto limbs = to_limbs(input);
+        const auto binary = convert_radix<binary_radix>(limbs.data(), limbs.size(), MAX_SIZE);
+        return {binary.begin(), binary.end()};
+    }
+
+    inline std::vector<long long> bigint::from_words(const std::vector<std::uint32_t>& input) {
+        const std::vector<limb_t> words(input.begin(), input.end());
+        const auto decimal = convert_radix<decimal_radix>(words.data(), words.size(), std::uint64_t{1} << 32);
+        if (decimal.empty()) return {0};
+        return {decimal.rbegin(), decimal.rend()};
+    }
+
+    inline std::vector<std::uint32_t> bigint::to_twos_complement(const bigint& input, const std::size_t words) {
+        auto result = to_words(input.vec);
+        result.resize(words, 0);
+        if (is_negative(input)) {
+            std::uint64_t carry = 1;
+            for (auto& word : result) {
+                const std::uint64_t val = static_cast<std::uint64_t>(static_cast<std::uint32_t>(~word)) + carry;
+                word = static_cast<std::uint32_t>(val);
+                carry = val >> 32;
+            }
+        }
+        return result;
+    }
+
+    inline bigint bigint::from_twos_complement(std::vector<std::uint32_t> input) {
+        const bool negative = !input.empty() && (input.back() >> 31) != 0;
+        if (negative) {
+            std::uint64_t carry = 1;
+            for (auto& word : input) {
+                const std::uint64_t val = static_cast<std::uint64_t>(static_cast<std::uint32_t>(~word)) + carry;
+                word = static_cast<std::uint32_t>(val);
+                carry = val >> 32;
+            }
+        }
+        while (!input.empty() && input.back() == 0) {
+            input.pop_back();
+        }
+
+        bigint result{from_words(input)};
+        result.is_neg = negative && result != 0;
+        return result;
+    }
+
+    inline void bigint::shift_left_small(std::vector<long long>& input, const std::size_t bits) {
+        long long carry = 0;
+        for (auto it = input.rbegin(); it != input.rend(); ++it) {
+            const long long val = (*it << bits) + carry;
+            *it = val % MAX_SIZE;
+            carry = val / MAX_SIZE;
         }
-        // (A) - (-B) == A + B
-        if (is_negative(rhs)) {
-            return add(lhs, abs(rhs));
+        if (carry > 0) {
+            input.insert(input.begin(), carry);
         }
-        // (-A) - (B) == -(A + B)
-        if (is_negative(lhs)) {
-            return negate(add(abs(lhs), rhs));
+    }
+
+    // Returns true if any non-zero bits were shifted out
+    inline bool bigint::shift_right_small(std::vector<long long>& input, const std::size_t bits) {
+        const long long mask = (1LL << bits) - 1;
+        long long remainder = 0;
+        for (auto& limb : input) {
+            const long long val = remainder * MAX_SIZE + limb;
+            limb = val >> bits;
+            remainder = val & mask;
         }
-        if (lhs < rhs) {
-            return negate(subtract(rhs, lhs));
+        if (input.size() > 1 && input.front() == 0) {
+            input.erase(input.begin());
         }
+        return remainder != 0;
+    }
 
-        std::vector<long long> result;
-        result.reserve(lhs.vec.size());
-        long long borrow = 0;
+    inline bigint& bigint::operator<<=(std::size_t shift) {
+        if (*this == 0 || shift == 0) return *this;
 
-        auto it_l = lhs.vec.rbegin();
-        auto it_r = rhs.vec.rbegin();
+        // A handful of in-place passes beats the round trip through binary
+        if (shift <= 4 * SHIFT_BITS) {
+            for (; shift > 0; shift -= std::min(shift, std::size_t{SHIFT_BITS})) {
+                shift_left_small(vec, std::min(shift, std::size_t{SHIFT_BITS}));
+            }
+            return *this;
+        }
 
-        while (it_l != lhs.vec.rend()) {
-            const long long l_val = *it_l;
-            const long long r_val = (it_r != rhs.vec.rend()) ? *it_r : 0;
+        const auto binary = to_words(vec);
+        std::vector<std::uint32_t> shifted(shift / 32, 0);
+        shifted.reserve(shift / 32 + binary.size() + 1);
+        const std::size_t bits = shift % 32;
+        std::uint32_t carry = 0;
+        for (const auto word : binary) {
+            shifted.push_back(bits == 0 ? word : (word << bits) | carry);
+            carry = bits == 0 ? 0 : word >> (32 - bits);
+        }
+        if (carry > 0) {
+            shifted.push_back(carry);
+        }
+        vec = from_words(shifted);
+        return *this;
+    }
 
-            long long diff = l_val - r_val - borrow;
-            if (diff < 0) {
-                diff += MAX_SIZE;
-                borrow = 1;
+    // Arithmetic shift, rounds towards negative infinity like the two's complement representation
+    inline bigint& bigint::operator>>=(std::size_t shift) {
+        if (*this == 0 || shift == 0) return *this;
+
+        const bool negative = is_neg;
+        bool inexact = false;
+        if (shift <= 4 * SHIFT_BITS) {
+            for (; shift > 0 && static_cast<bool>(*this); shift -= std::min(shift, std::size_t{SHIFT_BITS})) {
+                inexact |= shift_right_small(vec, std::min(shift, std::size_t{SHIFT_BITS}));
+            }
+        }
+        else {
+            const auto binary = to_words(vec);
+            const std::size_t words = shift / 32;
+            const std::size_t bits = shift % 32;
+            std::vector<std::uint32_t> shifted;
+            if (words < binary.size()) {
+                inexact = std::any_of(binary.begin(), binary.begin() + words, [](const std::uint32_t w) { return w != 0; });
+                inexact |= bits != 0 && (binary[words] & ((1U << bits) - 1)) != 0;
+                shifted.reserve(binary.size() - words);
+                for (std::size_t i = words; i < binary.size(); ++i) {
+                    const std::uint32_t high = i + 1 < binary.size() && bits != 0 ? binary[i + 1] << (32 - bits) : 0;
+                    shifted.push_back((binary[i] >> bits) | high);
+                }
+                while (!shifted.empty() && shifted.back() == 0) {
+                    shifted.pop_back();
+                }
             }
             else {
-                borrow = 0;
+                inexact = true;
             }
-            result.push_back(diff);
+            vec = from_words(shifted);
+        }
 
-            ++it_l;
-            if (it_r != rhs.vec.rend()) ++it_r;
+        if (!static_cast<bool>(*this)) {
+            is_neg = false;
         }
-        std::reverse(result.begin(), result.end());
-        return trim(bigint(std::move(result)));
+        if (negative && inexact) {
+            *this -= 1;
+        }
+        return *this;
     }
 
-    inline bigint bigint::multiply(const bigint& lhs, const bigint& rhs) {
-        if (lhs == 0 || rhs == 0) return 0;
-        if (lhs == 1) return rhs;
-        if (rhs == 1) return lhs;
-
-        if (is_negative(lhs) && is_negative(rhs)) {
-            return (abs(lhs) * abs(rhs));
-        }
-        if (is_negative(lhs) || is_negative(rhs)) {
-            return negate(abs(lhs) * abs(rhs));
+    inline bool bigint::test_bit(const bigint& input, const std::size_t bit) {
+        // Bit k of -m is the inverse of bit k of (m - 1)
+        if (is_negative(input)) {
+            return !test_bit(abs(input) - 1, bit);
         }
-        if (lhs < rhs) {
-            return multiply(rhs, lhs);
+        // 10^9 is a multiple of 2^9, so the lowest limb holds the lowest 9 bits
+        if (bit < 9) {
+            return ((input.vec.back() >> bit) & 1) != 0;
         }
+        return !is_even(input >> bit);
+    }
 
-        std::vector<long long> result(lhs.vec.size() + rhs.vec.size(), 0);
+    inline bigint bigint::set_bit(const bigint& input, const std::size_t bit) {
+        if (test_bit(input, bit)) return input;
+        return input | (bigint(1) << bit);
+    }
 
-        for (auto it_lhs = lhs.vec.rbegin(); it_lhs != lhs.vec.rend(); ++it_lhs) {
-            for (auto it_rhs = rhs.vec.rbegin(); it_rhs != rhs.vec.rend(); ++it_rhs) {
-                // Calculate the product and the corresponding indices in the result vector
-                long long mul = (*it_lhs) * (*it_rhs);
-                auto pos_low_it = result.rbegin() + (std::distance(lhs.vec.rbegin(), it_lhs) + std::distance(
-                                                         rhs.vec.rbegin(), it_rhs));
-                auto pos_high_it = pos_low_it + 1;
+    inline std::size_t bigint::popcount(const bigint& input) {
+        std::size_t count = 0;
+        for (auto word : to_words(input.vec)) {
+            for (; word != 0; word &= word - 1) {
+                ++count;
+            }
+        }
+        return count;
+    }
 
-                // Add the product to the result vector
-                *pos_low_it += mul % MAX_SIZE;
-                if (pos_high_it != result.rend()) {
-                    *pos_high_it += mul / MAX_SIZE;
-                }
+    inline std::size_t bigint::trailing_zeros(const bigint& input) {
+        if (input == 0) {
+            throw std::domain_error("Trailing zeros of zero are not defined.");
+        }
 
-                // Handle carry
-                if (*pos_low_it >= MAX_SIZE) {
-                    if (pos_high_it != result.rend()) {
-                        *pos_high_it += *pos_low_it / MAX_SIZE;
-                    }
-                    *pos_low_it %= MAX_SIZE;
-                }
+        std::size_t count = 0;
+        // 10^9 is a multiple of 2^9, so the lowest limb decides anything below 9 bits
+        if (input.vec.back() % 512 != 0) {
+            for (long long low = input.vec.back(); (low & 1) == 0; low >>= 1) {
+                ++count;
             }
+            return count;
+        }
+
+        const auto binary = to_words(input.vec);
+        auto it = binary.begin();
+        for (; *it == 0; ++it) {
+            count += 32;
+        }
+        for (std::uint32_t word = *it; (word & 1) == 0; word >>= 1) {
+            ++count;
         }
+        return count;
+    }
 
-        // Handle carries for remaining positions
-        for (auto r_iter = result.rbegin(); r_iter != result.rend() - 1; ++r_iter) {
-            if (*r_iter >= MAX_SIZE) {
-                *(r_iter + 1) += *r_iter / MAX_SIZE;
-                *r_iter %= MAX_SIZE;
+    template <typename Source>
+    bool bigint::read_number(Source& source, bigint& value) {
+        const bool negative = source.peek() == '-';
+        if (negative) source.bump();
+
+        std::vector<long long> limbs;
+        if (source.peek() == '0') {
+            source.bump();
+            const int prefix = source.peek();
+            if (prefix == 'x' || prefix == 'b') {
+                source.bump();
+                if (!read_power_of_two(source, prefix == 'x' ? 4 : 1, limbs)) return false;
+            }
+            else {
+                // Leading zeros are rejected as in from_chars
+                if (prefix >= '0' && prefix <= '9') return false;
+                limbs.push_back(0);
             }
         }
+        else if (!read_decimal(source, limbs)) {
+            return false;
+        }
 
-        return trim(result);
+        if (negative && limbs.size() == 1 && limbs.front() == 0) return false;
+        value.vec = std::move(limbs);
+        value.is_neg = negative;
+        return true;
     }
 
-
-    inline bigint bigint::divide(const bigint& numerator, const bigint& denominator) {
-        if (denominator == 0) {
-            throw std::domain_error("Attempted to divide by zero.");
+    template <typename Source>
+    bool bigint::read_decimal(Source& source, std::vector<long long>& limbs) {
+        // Group digits into limbs from the front since the total length is not known yet
+        long long limb = 0;
+        int in_limb = 0;
+        bool any = false;
+        for (int c = source.peek(); c >= '0' && c <= '9'; c = source.peek()) {
+            source.bump();
+            any = true;
+            limb = limb * 10 + (c - '0');
+            if (++in_limb == 9) {
+                limbs.push_back(limb);
+                limb = 0;
+                in_limb = 0;
+            }
+        }
+        if (!any) return false;
+
+        if (in_limb > 0) {
+            // Pad the last group to a full limb, then divide the whole number by the padding in one pass
+            long long scale = 1;
+            for (int i = in_limb; i < 9; ++i) scale *= 10;
+            limbs.push_back(limb * scale);
+            long long remainder = 0;
+            for (auto& x : limbs) {
+                const long long current = remainder * MAX_SIZE + x;
+                x = current / scale;
+                remainder = current % scale;
+            }
+            if (limbs.size() > 1 && limbs.front() == 0) limbs.erase(limbs.begin());
         }
-        if (numerator == denominator) return 1;
-        if (denominator == 1) return numerator;
-        if (numerator == 0) return 0;
+        return true;
+    }
 
-        if (is_negative(numerator) && is_negative(denominator)) {
-            return divide(abs(numerator), abs(denominator));
+    template <typename Source>
+    bool bigint::read_power_of_two(Source& source, const int bits_per_digit, std::vector<long long>& limbs) {
+        const int per_word = 32 / bits_per_digit;
+        std::vector<std::uint32_t> words;
+        std::uint32_t word = 0;
+        int in_word = 0;
+        bool any = false;
+        for (;;) {
+            const int c = source.peek();
+            std::uint32_t digit;
+            if (c >= '0' && c <= '9')      digit = c - '0';
+            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+            else break;
+            if (digit >> bits_per_digit != 0) break;
+
+            source.bump();
+            any = true;
+            word = word << bits_per_digit | digit;
+            if (++in_word == per_word) {
+                words.push_back(word);
+                word = 0;
+                in_word = 0;
+            }
         }
-        if (is_negative(numerator) || is_negative(denominator)) {
-            return negate(divide(abs(numerator), abs(denominator)));
+        if (!any) return false;
+
+        // Full words arrived most significant first; shift them up to make room for the partial word
+        std::reverse(words.begin(), words.end());
+        if (in_word > 0) {
+            const int shift = in_word * bits_per_digit;
+            std::uint32_t carry = word;
+            for (auto& w : words) {
+                const std::uint32_t next = w >> (32 - shift);
+                w = w << shift | carry;
+                carry = next;
+            }
+            words.push_back(carry);
         }
-        if (numerator < denominator) {
-            return 0;
+        while (!words.empty() && words.back() == 0) words.pop_back();
+        limbs = from_words(words);
+        return true;
+    }
+
+    inline bool bigint_reader::refill() {
+        position = 0;
+        filled = 0;
+        if (stream != nullptr) {
+            stream->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            filled = static_cast<std::size_t>(stream->gcount());
         }
-        if (numerator.vec.size() <= 1) {
-            return numerator.vec.back() / denominator.vec.back();
+#ifdef BIGINT_POSIX
+        else {
+            ssize_t count;
+            do {
+                count = ::read(fd, buffer.data(), buffer.size());
+            } while (count < 0 && errno == EINTR);
+            if (count < 0) throw std::runtime_error("Failed to read from file descriptor.");
+            filled = static_cast<std::size_t>(count);
         }
+#endif
+        return filled > 0;
+    }
 
-        bigint remainder = numerator;
-        bigint quotient = 0;
+    inline bool bigint_reader::read(bigint& value) {
+        int c = peek();
+        while (c >= 0 && std::isspace(c)) {
+            bump();
+            c = peek();
+        }
+        if (c < 0) return false;
 
-        while (remainder >= denominator) {
-            int count = count_digits(remainder) - count_digits(denominator) - 1;
+        bigint result;
+        if (!bigint::read_number(*this, result)) {
+            throw std::runtime_error("Invalid Big Integer.");
+        }
+        c = peek();
+        if (c >= 0 && !std::isspace(c)) {
+            throw std::runtime_error("Invalid Big Integer.");
+        }
+        value = std::move(result);
+        return true;
+    }
 
-            // Prevent negative exponents which cause pow() to return 0
-            if (count < 0) {
-                count = 0;
+    inline bigint bigint::import_words(const void* data, const std::size_t count, const std::size_t word_size,
+                                       const byte_order endian, const word_order order) {
+        if (word_size == 0) throw std::domain_error("Word size must be positive.");
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        const std::size_t total = count * word_size;
+        const bool little = endian == byte_order::little || (endian == byte_order::native && little_endian_host());
+
+        std::vector<std::uint32_t> words((total + 3) / 4, 0);
+        // Like mpz_import, a null buffer is fine when there is nothing to read
+        if (total == 0) return 0;
+        if (little && order == word_order::least_significant_first && little_endian_host()) {
+            std::memcpy(words.data(), bytes, total);
+        }
+        else {
+            for (std::size_t i = 0; i < total; ++i) {
+                words[i / 4] |= static_cast<std::uint32_t>(bytes[byte_offset(i, count, word_size, little, order)]) << (8 * (i % 4));
             }
+        }
+        while (!words.empty() && words.back() == 0) words.pop_back();
+        return bigint(from_words(words));
+    }
 
-            bigint numerator_size = pow(10, count);
-            bigint temp = denominator * numerator_size;
+    inline std::size_t bigint::export_size(const bigint& value, const std::size_t word_size) {
+        if (word_size == 0) throw std::domain_error("Word size must be positive.");
+        return (words_bit_length(to_words(value.vec)) + 8 * word_size - 1) / (8 * word_size);
+    }
 
-            // Repeatedly subtract the chunk from the remainder
-            while (remainder >= temp) {
-                remainder -= temp;
-                quotient += numerator_size;
+    inline std::size_t bigint::export_words(const bigint& value, void* data, const std::size_t capacity, const std::size_t word_size,
+                                            const byte_order endian, const word_order order) {
+        if (word_size == 0) throw std::domain_error("Word size must be positive.");
+        auto words = to_words(value.vec);
+        const std::size_t count = (words_bit_length(words) + 8 * word_size - 1) / (8 * word_size);
+        if (capacity < count) throw std::length_error("Buffer too small for exported words.");
+
+        if (count == 0) return 0;
+        auto* bytes = static_cast<unsigned char*>(data);
+        const std::size_t total = count * word_size;
+        const bool little = endian == byte_order::little || (endian == byte_order::native && little_endian_host());
+        words.resize((total + 3) / 4, 0);
+        if (little && order == word_order::least_significant_first && little_endian_host()) {
+            std::memcpy(bytes, words.data(), total);
+        }
+        else {
+            for (std::size_t i = 0; i < total; ++i) {
+                bytes[byte_offset(i, count, word_size, little, order)] = static_cast<unsigned char>(words[i / 4] >> (8 * (i % 4)));
             }
         }
-
-        return quotient;
+        return count;
     }
 
-    inline bigint bigint::sqrt(const bigint& input) {
-        if (is_negative(input))
-            throw std::domain_error("Square root of a negative number is complex");
-
-        if (input == 0 || input == 1)
-            return input;
+    inline void bigint::write_varint(std::uint64_t value, std::vector<std::uint8_t>& out) {
+        for (; value >= 0x80; value >>= 7) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
 
-        bigint oom = log10(input / 2);
-        oom /= 2;
-        bigint low_end = pow(10, (oom));
-        bigint high_end = pow(10, (oom) + 2);
-        bigint mid_point, square, answer;
-        while (low_end <= high_end) {
-            mid_point = (low_end + high_end) / 2;
-            square = mid_point * mid_point;
-            if (square == input)
-                return mid_point;
+    inline std::size_t bigint::varint_size(std::uint64_t value) {
+        std::size_t size = 1;
+        for (; value >= 0x80; value >>= 7) ++size;
+        return size;
+    }
 
-            if (square < input) {
-                low_end = mid_point + 1;
-                answer = mid_point;
-            }
-            else {
-                high_end = mid_point - 1;
-            }
+    inline std::uint64_t bigint::read_varint(const std::uint8_t*& first, const std::uint8_t* last) {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (first == last) break;
+            const std::uint8_t byte = *first++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
         }
-        return answer;
+        throw std::runtime_error("Invalid serialized bigint.");
     }
 
-    inline bigint bigint::log2(const bigint& input) {
-        if (is_negative(input) || input == 0)
-            throw std::domain_error("Invalid input for natural log");
+    inline std::size_t bigint::serialized_size(const bigint& value) {
+        if (value.vec.size() <= 2) {
+            return 1 + varint_size(static_cast<std::uint64_t>(to_uint64(abs(value), "Value does not fit in 64 bits.")));
+        }
+        return 1 + varint_size(value.vec.size()) + 4 * value.vec.size();
+    }
 
-        if (input == 1)
-            return 0;
+    inline void bigint::serialize(const bigint& value, std::vector<std::uint8_t>& out) {
+        out.reserve(out.size() + serialized_size(value));
+        serialize_limbs(span_of(value), out);
+    }
 
-        if (input.vec.size() == 1) {
-            return std::log2(input.vec.back());
+    inline void bigint::serialize_limbs(const limb_span value, std::vector<std::uint8_t>& out) {
+        const bool compact = value.size <= 2;
+        out.push_back(static_cast<std::uint8_t>(SERIAL_VERSION << 4 | (compact ? 0 : 2) | (value.negative ? 1 : 0)));
+        if (compact) {
+            const auto low = static_cast<std::uint64_t>(value.data[value.size - 1]);
+            write_varint(value.size == 2 ? static_cast<std::uint64_t>(value.data[0]) * MAX_SIZE + low : low, out);
+            return;
         }
 
-        bigint exponent = 0;
-        while (pow(2, exponent) <= input) {
-            ++exponent;
+        write_varint(value.size, out);
+        for (std::size_t limb = 0; limb < value.size; ++limb) {
+            for (int i = 0; i < 4; ++i) {
+                out.push_back(static_cast<std::uint8_t>(value.data[limb] >> (8 * i)));
+            }
         }
+    }
 
-        return exponent;
-        // TODO: Convert to using division after checking bigO of division vs multiplication
-        //    std::string logVal = "-1";
-        //    while(s != "0") {
-        //        logVal = add(logVal, "1");
-        //        s = divide(s, "2");
-        //    }
-        //    return logVal;
+    inline bigint bigint::deserialize(const std::uint8_t*& first, const std::uint8_t* last) {
+        return bigint_view::parse(first, last).to_bigint();
     }
 
-    inline bigint bigint::log10(const bigint& input) {
-        if (is_negative(input) || input == 0)
-            throw std::domain_error("Invalid input for log base 10");
+    inline void bigint::save_file(const bigint& value, const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("Failed to open " + path + " for writing.");
 
-        if (input == 1)
-            return 0;
+        std::vector<std::uint8_t> chunk;
+        if (value.vec.size() <= 2) {
+            serialize(value, chunk);
+        }
+        else {
+            chunk.push_back(static_cast<std::uint8_t>(SERIAL_VERSION << 4 | 2 | (is_negative(value) ? 1 : 0)));
+            write_varint(value.vec.size(), chunk);
+        }
 
-        return count_digits(input) - 1;
+        // Stream the limbs through a fixed-size chunk
+        constexpr std::size_t chunk_limbs = std::size_t{1} << 14;
+        for (std::size_t first = 0; value.vec.size() > 2 && first < value.vec.size(); first += chunk_limbs) {
+            const std::size_t last = std::min(first + chunk_limbs, value.vec.size());
+            for (std::size_t i = first; i < last; ++i) {
+                for (int byte = 0; byte < 4; ++byte) {
+                    chunk.push_back(static_cast<std::uint8_t>(value.vec[i] >> (8 * byte)));
+                }
+            }
+            file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+            chunk.clear();
+        }
+        file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        if (!file) throw std::runtime_error("Failed to write " + path + ".");
     }
 
-    inline bigint bigint::logwithbase(const bigint& input, const bigint& base) {
-        auto top = log2(input);
-        auto bottom = log2(base);
-        auto answer = divide(top, bottom);
-        return answer;
+    inline mapped_bigint bigint::map_file(const std::string& path) {
+        return mapped_bigint(path);
     }
 
-    inline bigint bigint::antilog2(const bigint& input) {
-        return pow(2, input);
+    inline long long bigint::low_limb(const bigint_view& view, const std::size_t p) {
+        return p < view.size() ? view.limb(view.size() - 1 - p) : 0;
     }
 
-    inline bigint bigint::antilog10(const bigint& input) {
-        return pow(10, input);
+    inline int bigint::compare_views(const bigint_view& lhs, const bigint_view& rhs) {
+        if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            const std::uint32_t a = lhs.limb(i), b = rhs.limb(i);
+            if (a != b) return a < b ? -1 : 1;
+        }
+        return 0;
     }
 
-    inline void bigint::swap(bigint& lhs, bigint& rhs) {
-        const bigint temp = lhs;
-        lhs = rhs;
-        rhs = temp;
+    inline int bigint::compare(const bigint_view& lhs, const bigint_view& rhs) {
+        if (lhs.is_negative() != rhs.is_negative()) return lhs.is_negative() ? -1 : 1;
+        const int order = compare_views(lhs, rhs);
+        return lhs.is_negative() ? -order : order;
     }
 
-    inline bigint bigint::gcd(const bigint& lhs, const bigint& rhs) {
-        bigint temp_l = lhs, temp_r = rhs, remainder;
-        if (rhs > lhs)
-            swap(temp_l, temp_r);
-
-        while (rhs > 0) {
-            remainder = temp_l % temp_r;
-            temp_l = temp_r;
-            temp_r = remainder;
+    inline void bigint::check_stream_factor(const long long factor) {
+        if (factor <= -MAX_SIZE || factor >= MAX_SIZE) {
+            throw std::domain_error("Streaming factor must be below 10^9 in magnitude.");
         }
-        return temp_l;
     }
 
-    inline bigint bigint::factorial(const bigint& input) {
-        if (is_negative(input)) {
-            throw std::runtime_error("Factorial of Negative Integer is not defined.");
+    template <typename Generator>
+    void bigint::write_streamed(const bool negative, const std::size_t limit, Generator next, const std::string& path) {
+        // A dry run finds the most significant non-zero limb, so the header can go ahead of the limbs
+        std::size_t count = 1;
+        {
+            Generator probe = next;
+            for (std::size_t p = 0; p < limit; ++p) {
+                if (probe() != 0) count = p + 1;
+            }
+        }
+        if (count <= 2) {
+            std::vector<long long> limbs(count);
+            for (std::size_t p = 0; p < count; ++p) limbs[count - 1 - p] = next();
+            bigint small(std::move(limbs));
+            small.is_neg = negative && small != 0;
+            save_file(small, path);
+            return;
         }
-        if (input == 0)
-            return 1;
 
-        bigint ans = 1;
-        bigint temp = input;
-        while (temp != 0) {
-            ans *= temp;
-            temp -= 1;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("Failed to open " + path + " for writing.");
+        std::vector<std::uint8_t> chunk;
+        chunk.push_back(static_cast<std::uint8_t>(SERIAL_VERSION << 4 | 2 | (negative ? 1 : 0)));
+        write_varint(count, chunk);
+        const std::size_t header = chunk.size();
+        file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+
+        // Each chunk is stored reversed, in front of the one written before it
+        constexpr std::size_t chunk_limbs = std::size_t{1} << 14;
+        for (std::size_t p = 0; p < count; p += chunk_limbs) {
+            const std::size_t size = std::min(chunk_limbs, count - p);
+            chunk.resize(4 * size);
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto limb = static_cast<std::uint32_t>(next());
+                std::uint8_t* bytes = &chunk[4 * (size - 1 - i)];
+                for (int byte = 0; byte < 4; ++byte) bytes[byte] = static_cast<std::uint8_t>(limb >> (8 * byte));
+            }
+            file.seekp(static_cast<std::streamoff>(header + 4 * (count - p - size)));
+            file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
         }
-        return ans;
+        if (!file) throw std::runtime_error("Failed to write " + path + ".");
     }
 
-    /* Simplest form of prime checking, implement your own
-     */
-    inline bool bigint::is_prime(const bigint& s) {
-        if (is_negative(s) || s == 1)
-            return false;
+    inline void bigint::add_views(const bigint_view& lhs, const bigint_view& rhs, const bool rhs_negative,
+                                  const std::string& path) {
+        std::size_t p = 0;
+        long long carry = 0;
+        if (lhs.is_negative() == rhs_negative) {
+            write_streamed(rhs_negative, std::max(lhs.size(), rhs.size()) + 1, [=]() mutable {
+                const long long sum = low_limb(lhs, p) + low_limb(rhs, p) + carry;
+                ++p;
+                carry = sum >= MAX_SIZE ? 1 : 0;
+                return sum - carry * MAX_SIZE;
+            }, path);
+            return;
+        }
 
-        if (s == 2 || s == 3 || s == 5)
-            return true;
+        // Opposite signs: the smaller magnitude comes off the larger one, whose sign the result takes
+        const int order = compare_views(lhs, rhs);
+        if (order == 0) return save_file(0, path);
+        const bigint_view& larger = order > 0 ? lhs : rhs;
+        const bigint_view& smaller = order > 0 ? rhs : lhs;
+        write_streamed(order > 0 ? lhs.is_negative() : rhs_negative, larger.size(), [=]() mutable {
+            long long difference = low_limb(larger, p) - low_limb(smaller, p) - carry;
+            ++p;
+            carry = difference < 0 ? 1 : 0;
+            return difference + carry * MAX_SIZE;
+        }, path);
+    }
 
-        if (is_even(s) || s % 5 == 0)
-            return false;
+    inline void bigint::add_to_file(const bigint_view& lhs, const bigint_view& rhs, const std::string& path) {
+        add_views(lhs, rhs, rhs.is_negative(), path);
+    }
 
-        for (bigint i = 3; i * i <= s; i += 2) {
-            if ((s % i) == 0) {
-                return false;
+    inline void bigint::subtract_to_file(const bigint_view& lhs, const bigint_view& rhs, const std::string& path) {
+        add_views(lhs, rhs, !rhs.is_negative() && !(rhs.size() == 1 && rhs.limb(0) == 0), path);
+    }
+
+    inline void bigint::multiply_to_file(const bigint_view& lhs, const long long factor, const std::string& path) {
+        check_stream_factor(factor);
+        const long long magnitude = factor < 0 ? -factor : factor;
+        std::size_t p = 0;
+        long long carry = 0;
+        write_streamed(lhs.is_negative() != (factor < 0), lhs.size() + 1, [=]() mutable {
+            const long long product = low_limb(lhs, p) * magnitude + carry;
+            ++p;
+            carry = product / MAX_SIZE;
+            return product % MAX_SIZE;
+        }, path);
+    }
+
+    inline long long bigint::divide_to_file(const bigint_view& lhs, const long long divisor, const std::string& path) {
+        if (divisor == 0) throw std::domain_error("Attempted to divide by zero.");
+        check_stream_factor(divisor);
+        const long long magnitude = divisor < 0 ? -divisor : divisor;
+        const bool negative = lhs.is_negative() != (divisor < 0);
+
+        // Short division from the top; only the leading quotient limb can be zero
+        const std::size_t n = lhs.size();
+        const std::size_t skipped = n > 1 && lhs.limb(0) < magnitude ? 1 : 0;
+        long long remainder = skipped != 0 ? lhs.limb(0) : 0;
+        const auto next = [&](const std::size_t i) {
+            const long long current = remainder * MAX_SIZE + lhs.limb(i);
+            remainder = current % magnitude;
+            return current / magnitude;
+        };
+
+        if (n - skipped <= 2) {
+            std::vector<long long> limbs;
+            for (std::size_t i = skipped; i < n; ++i) limbs.push_back(next(i));
+            bigint quotient(std::move(limbs));
+            quotient.is_neg = negative && quotient != 0;
+            save_file(quotient, path);
+        }
+        else {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) throw std::runtime_error("Failed to open " + path + " for writing.");
+            std::vector<std::uint8_t> chunk;
+            chunk.push_back(static_cast<std::uint8_t>(SERIAL_VERSION << 4 | 2 | (negative ? 1 : 0)));
+            write_varint(n - skipped, chunk);
+
+            constexpr std::size_t chunk_limbs = std::size_t{1} << 14;
+            for (std::size_t first = skipped; first < n; first += chunk_limbs) {
+                const std::size_t last = std::min(first + chunk_limbs, n);
+                for (std::size_t i = first; i < last; ++i) {
+                    const auto limb = static_cast<std::uint32_t>(next(i));
+                    for (int byte = 0; byte < 4; ++byte) chunk.push_back(static_cast<std::uint8_t>(limb >> (8 * byte)));
+                }
+                file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+                chunk.clear();
             }
+            if (!file) throw std::runtime_error("Failed to write " + path + ".");
         }
-        return true;
+        return lhs.is_negative() ? -remainder : remainder;
     }
 
-    inline bigint bigint::random(const size_t length) {
-        constexpr char charset[] = "0123456789";
-        std::default_random_engine rng(std::random_device{}());
+    inline mapped_bigint::mapped_bigint(const std::string& path) {
+#ifdef BIGINT_POSIX
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Failed to open " + path + ".");
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat " + path + ".");
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length > 0) {
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                ::madvise(address, length, MADV_SEQUENTIAL);
+                data = static_cast<const std::uint8_t*>(address);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+#endif
+        if (!mapped) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) throw std::runtime_error("Failed to open " + path + ".");
+            fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data = fallback.data();
+            length = fallback.size();
+        }
 
-        // Distribution for the first digit (1-9)
-        std::uniform_int_distribution<> first_dist(1, 9);
-        // Distribution for the other digits (0-9)
-        std::uniform_int_distribution<> dist(0, 9);
+        const std::uint8_t* cursor = data;
+        try {
+            parsed = bigint_view::parse(cursor, data + length);
+            if (cursor != data + length) throw std::runtime_error("Invalid serialized bigint.");
+        }
+        catch (...) {
+            release();
+            throw;
+        }
+    }
 
-        // Lambda to generate the first character
-        auto randchar_first = [charset, &first_dist, &rng]() { return charset[first_dist(rng)]; };
-        // Lambda to generate subsequent characters
-        auto randchar = [charset, &dist, &rng]() { return charset[dist(rng)]; };
+    inline void mapped_bigint::release() noexcept {
+#ifdef BIGINT_POSIX
+        if (mapped) {
+            ::munmap(const_cast<std::uint8_t*>(data), length);
+            mapped = false;
+        }
+#endif
+    }
 
-        // Create a string with the specified length
-        std::string str(length, 0);
+    inline bigint_view bigint_view::parse(const std::uint8_t*& first, const std::uint8_t* last) {
+        const auto invalid = [] { return std::runtime_error("Invalid serialized bigint."); };
+        const std::uint8_t* cursor = first;
+        if (cursor == last || *cursor >> 4 != bigint::SERIAL_VERSION || (*cursor & 0x0C) != 0) throw invalid();
+
+        bigint_view view;
+        const std::uint8_t tag = *cursor++;
+        view.negative = (tag & 1) != 0;
+        if ((tag & 2) == 0) {
+            view.compact = bigint::read_varint(cursor, last);
+            if (view.compact >= static_cast<std::uint64_t>(bigint::MAX_SIZE) * bigint::MAX_SIZE) throw invalid();
+            view.count = view.compact >= static_cast<std::uint64_t>(bigint::MAX_SIZE) ? 2 : 1;
+        }
+        else {
+            view.count = static_cast<std::size_t>(bigint::read_varint(cursor, last));
+            if (view.count == 0 || view.count > static_cast<std::size_t>(last - cursor) / 4) throw invalid();
+            view.limbs = cursor;
+            cursor += 4 * view.count;
+            for (std::size_t i = 0; i < view.count; ++i) {
+                if (view.limb(i) >= bigint::MAX_SIZE) throw invalid();
+            }
+            if (view.count > 1 && view.limb(0) == 0) throw invalid();
+        }
+        if (view.negative && view.count == 1 && view.limb(0) == 0) throw invalid();
 
-        // Generate the first character separately to ensure it's not '0'
-        str[0] = randchar_first();
+        first = cursor;
+        return view;
+    }
 
-        // Generate the remaining characters
-        std::generate_n(str.begin() + 1, length - 1, randchar);
+    inline std::uint32_t bigint_view::limb(const std::size_t i) const {
+        if (limbs == nullptr) {
+            const auto base = static_cast<std::uint64_t>(bigint::MAX_SIZE);
+            return static_cast<std::uint32_t>(count == 2 && i == 0 ? compact / base : compact % base);
+        }
+        const std::uint8_t* bytes = limbs + 4 * i;
+        return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+               static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    }
 
-        return {str};
+    inline bigint bigint_view::to_bigint() const {
+        std::vector<long long> vec(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            vec[i] = limb(i);
+        }
+        bigint result(std::move(vec));
+        result.is_neg = negative;
+        return result;
+    }
+    inline std::size_t bigint::hash_limbs(const limb_span value) {
+        std::size_t seed = value.size;
+        for (std::size_t i = 0; i < value.size; ++i) {
+            long long x = value.data[i];
+            x = ((x >> 16) ^ x) * 0x45d9f3b;
+            x = ((x >> 16) ^ x) * 0x45d9f3b;
+            x = (x >> 16) ^ x;
+            seed ^= x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        if (value.negative) {
+            seed ^= 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
     }
 
-    inline std::vector<long long> bigint::string_to_vector(std::string input) {
-        // Break into chunks of 9 characters
-        std::vector<long long> result;
-        constexpr int chunk_size = 9;
-        const int size = input.size();
+    inline bigint::limb_span bigint::span_of(const bigint_array& array, const std::size_t i) {
+        return {array.arena.data() + array.offsets[i], array.lengths[i], array.signs[i] != 0};
+    }
 
-        if (size > chunk_size) {
-            // Pad the length to get appropriate sized chunks
-            if (int mod = size % chunk_size; mod != 0) {
-                input.insert(0, chunk_size - mod, '0');
-            }
+    template <typename Kernel, typename Bound, typename Cost>
+    bigint_array bigint::batch_arrays(const bigint_array& a, const bigint_array& b, const std::size_t threads,
+                                      Kernel kernel, Bound bound, Cost cost) {
+        check_batch(a.size(), b.size(), a.size());
+        const std::size_t count = a.size();
+
+        // Every result gets a slot of its upper bound, so workers write disjoint parts of the arena
+        bigint_array result;
+        result.offsets.resize(count);
+        result.lengths.resize(count);
+        result.signs.resize(count);
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            result.offsets[i] = total;
+            total += bound(a.lengths[i], b.lengths[i]);
         }
-        for (int i = 0; i < input.size(); i += chunk_size) {
-            std::string temp_str = input.substr(i, chunk_size);
-            result.emplace_back(stoll(temp_str));
+        result.arena.resize(total);
+
+        batch_run(count, threads,
+                  [&](const std::size_t i) { return cost(a.lengths[i], b.lengths[i]); },
+                  [&](const std::size_t i) {
+                      auto& out = scratch().result;
+                      const bool negative = kernel(span_of(a, i), span_of(b, i), out);
+                      std::copy(out.begin(), out.end(), result.arena.begin() + static_cast<std::ptrdiff_t>(result.offsets[i]));
+                      result.lengths[i] = out.size();
+                      result.signs[i] = negative;
+                  });
+
+        // Close the gaps left by results shorter than their bound
+        std::size_t used = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto first = result.arena.begin() + static_cast<std::ptrdiff_t>(result.offsets[i]);
+            std::copy(first, first + static_cast<std::ptrdiff_t>(result.lengths[i]),
+                      result.arena.begin() + static_cast<std::ptrdiff_t>(used));
+            result.offsets[i] = used;
+            used += result.lengths[i];
         }
+        result.arena.resize(used);
+        return result;
+    }
+
+    inline bigint_array bigint::batch_add(const bigint_array& a, const bigint_array& b, const std::size_t threads) {
+        return batch_arrays(a, b, threads, add_into,
+                            [](const std::size_t l, const std::size_t r) { return std::max(l, r) + 1; },
+                            [](const std::size_t l, const std::size_t r) { return std::max(l, r); });
+    }
+
+    inline bigint_array bigint::batch_mul(const bigint_array& a, const bigint_array& b, const std::size_t threads) {
+        return batch_arrays(a, b, threads, multiply_into,
+                            [](const std::size_t l, const std::size_t r) { return l + r; },
+                            [](const std::size_t l, const std::size_t r) { return l * r; });
+    }
+
+    inline bigint_array bigint::batch_mod(const bigint_array& a, const bigint_array& m, const std::size_t threads) {
+        return batch_arrays(a, m, threads, mod_into,
+                            [](const std::size_t, const std::size_t r) { return r; },
+                            [](const std::size_t l, const std::size_t r) { return l * r; });
+    }
 
+    inline bigint bigint_array::element::to_bigint() const {
+        bigint result(std::vector<long long>(limbs, limbs + count));
+        result.is_neg = negative;
         return result;
     }
 
-    inline std::vector<long long> bigint::hex_to_vector(std::string input) {
-        // Strip "0x" prefix
-        const std::string hex = input.substr(2);
+    inline std::size_t bigint_array::element::hash() const {
+        return bigint::hash_limbs({limbs, count, negative});
+    }
+
+    inline int bigint_array::element::compare(const element& lhs, const element& rhs) {
+        return bigint::compare_spans({lhs.limbs, lhs.count, lhs.negative}, {rhs.limbs, rhs.count, rhs.negative});
+    }
 
-        std::vector<long long> result = {0};
+    inline void bigint_array::push_back(const bigint& value) {
+        offsets.push_back(arena.size());
+        lengths.push_back(value.vec.size());
+        signs.push_back(value.is_neg ? 1 : 0);
+        arena.insert(arena.end(), value.vec.begin(), value.vec.end());
+    }
 
-        for (const char c : hex) {
-            unsigned long long digit;
-            if (c >= '0' && c <= '9')      digit = c - '0';
-            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
-            else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
-            else throw std::runtime_error("Invalid hex character.");
+    inline void bigint_array::push_back(const bigint_view& value) {
+        offsets.push_back(arena.size());
+        lengths.push_back(value.size());
+        signs.push_back(value.is_negative() ? 1 : 0);
+        for (std::size_t i = 0; i < value.size(); ++i) arena.push_back(value.limb(i));
+    }
 
-            // Multiply current value by 16 and add digit.
-            // Max intermediate value: (MAX_SIZE-1)*16+15 = 15,999,999,999
-            // which fits in unsigned long long.
-            unsigned long long carry = digit;
-            for (int i = static_cast<int>(result.size()) - 1; i >= 0; --i) {
-                const unsigned long long val = static_cast<unsigned long long>(result[i]) * 16 + carry;
-                result[i] = static_cast<long long>(val % static_cast<unsigned long long>(MAX_SIZE));
-                carry = val / static_cast<unsigned long long>(MAX_SIZE);
-            }
-            // carry <= 15 < MAX_SIZE, so this loop runs at most once
-            while (carry > 0) {
-                result.insert(result.begin(), static_cast<long long>(carry % static_cast<unsigned long long>(MAX_SIZE)));
-                carry /= static_cast<unsigned long long>(MAX_SIZE);
-            }
+    inline void bigint_array::sort() {
+        std::vector<std::size_t> order(size());
+        for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [this](const std::size_t l, const std::size_t r) {
+            return element::compare((*this)[l], (*this)[r]) < 0;
+        });
+
+        bigint_array sorted;
+        sorted.reserve(size(), limb_count());
+        for (const std::size_t i : order) {
+            sorted.offsets.push_back(sorted.arena.size());
+            sorted.lengths.push_back(lengths[i]);
+            sorted.signs.push_back(signs[i]);
+            const auto first = arena.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+            sorted.arena.insert(sorted.arena.end(), first, first + static_cast<std::ptrdiff_t>(lengths[i]));
         }
+        *this = std::move(sorted);
+    }
 
-        return result;
+    inline std::size_t bigint_array::hash() const {
+        std::size_t seed = size();
+        for (std::size_t i = 0; i < size(); ++i) {
+            seed ^= (*this)[i].hash() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
     }
 
-    inline std::string bigint::vector_to_string(const std::vector<long long>& input) {
-        std::stringstream ss;
-        bool first = true;
-        for (const auto partial : input) {
-            if (first) {
-                ss << partial; // No padding for the first number
-                first = false;
-            }
-            else {
-                ss << std::setw(9) << std::setfill('0') << partial; // Pad to 9 digits
-            }
+    inline void bigint_array::serialize(std::vector<std::uint8_t>& out) const {
+        for (std::size_t i = 0; i < size(); ++i) {
+            bigint::serialize_limbs(bigint::span_of(*this, i), out);
         }
-        return ss.str();
     }
 
-    inline int bigint::count_digits(const bigint& input) {
-        std::string my_string = vector_to_string(input.vec);
-        return static_cast<int>(my_string.length());
+    inline bigint_array bigint_array::deserialize(const std::uint8_t* first, const std::uint8_t* last) {
+        bigint_array result;
+        while (first != last) {
+            result.push_back(bigint_view::parse(first, last));
+        }
+        return result;
     }
 } // namespace::BigInt
 
@@ -916,17 +5402,15 @@ template<>
 struct std::hash<BigInt::bigint>
 {
     std::size_t operator()(const BigInt::bigint& input) const noexcept {
-        std::size_t seed = input.vec.size();
-        for (auto x : input.vec) {
-            x = ((x >> 16) ^ x) * 0x45d9f3b;
-            x = ((x >> 16) ^ x) * 0x45d9f3b;
-            x = (x >> 16) ^ x;
-            seed ^= x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-        }
-        if (input.is_neg) {
-            seed ^= 0x9e3779b9 + (seed << 6) + (seed >> 2);
-        }
-        return seed;
+        return BigInt::bigint::hash_limbs(BigInt::bigint::span_of(input));
+    }
+};
+
+template<>
+struct std::hash<BigInt::bigint_array>
+{
+    std::size_t operator()(const BigInt::bigint_array& input) const noexcept {
+        return input.hash();
     }
 };
 
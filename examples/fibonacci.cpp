@@ -3,37 +3,25 @@
  * 
  * This example demonstrates calculating large Fibonacci numbers using BigInt.
  * Fibonacci numbers grow exponentially, and F(94) already exceeds the capacity 
- * of a 64-bit unsigned integer.
+ * of a 64-bit unsigned integer. bigint::fibonacci uses fast doubling, so F(n)
+ * costs O(log n) multiplications.
  */
 #include <iostream>
 #include "../bigint.h"
 
 using namespace BigInt;
 
-// Simple iterative Fibonacci implementation using bigint
-bigint fibonacci(const bigint& n) {
-    if (n <= 0) return 0;
-    if (n == 1) return 1;
-
-    bigint a = 0;
-    bigint b = 1;
-    bigint f = 0;
-
-    for (bigint i = 2; i <= n; ++i) {
-        f = a + b;
-        a = b;
-        b = f;
-    }
-    return f;
-}
-
 int main() {
     const int max_n = 500;
     std::cout << "Calculating Fibonacci sequence up to F(" << max_n << ")..." << std::endl;
 
     for (int i = 0; i <= max_n; ++i) {
-        std::cout << "F(" << i << ") = " << fibonacci(i) << std::endl;
+        std::cout << "F(" << i << ") = " << bigint::fibonacci(i) << std::endl;
     }
-    
+
+    // Fast doubling makes single far-away terms cheap
+    const bigint far = bigint::fibonacci(100000);
+    std::cout << "F(100000) has " << bigint::count_digits(far) << " digits" << std::endl;
+
     return 0;
 }
\ No newline at end of file
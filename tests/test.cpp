@@ -9,6 +9,7 @@
 #include <string_view>
 #include <sstream>
 #include <unordered_set>
+#include <list>
 
 #include "../bigint.h"
 
@@ -433,6 +434,28 @@ TEST(Test_BigInt, Comparison_Tests) {
     EXPECT_TRUE(123456789 <= huge_number1);
     EXPECT_FALSE(123456789 == huge_number1);
     EXPECT_FALSE(123456789 >= huge_number1);
+
+    // Three-way compare and built-in integers at the edges of their range
+    const bigint llong_max("9223372036854775807"), ullong_max("18446744073709551615");
+    EXPECT_EQ(bigint::compare(huge_number2, huge_number1), -1);
+    EXPECT_EQ(bigint::compare(-huge_number2, -huge_number1), 1);
+    EXPECT_EQ(bigint::compare(huge_number1, huge_number1), 0);
+    EXPECT_EQ(bigint::compare(llong_max, std::numeric_limits<long long>::max()), 0);
+    EXPECT_EQ(bigint::compare(-llong_max - 1, std::numeric_limits<long long>::min()), 0);
+    EXPECT_EQ(bigint::compare(-llong_max - 2, std::numeric_limits<long long>::min()), -1);
+    EXPECT_EQ(bigint::compare(ullong_max, std::numeric_limits<unsigned long long>::max()), 0);
+    EXPECT_EQ(bigint::compare(ullong_max + 1, std::numeric_limits<unsigned long long>::max()), 1);
+    EXPECT_EQ(bigint::compare(bigint(-1), 0u), -1);
+    EXPECT_EQ(bigint::compare(bigint(1000000000), 999999999), 1);
+    EXPECT_EQ(bigint::compare(bigint(-1000000000), -999999999), -1);
+    EXPECT_TRUE(bigint(7) == '7');
+    EXPECT_TRUE(ullong_max > std::numeric_limits<long long>::max());
+    EXPECT_TRUE(std::size_t{3} < bigint(4));
+#if __cplusplus >= 202002L
+    EXPECT_TRUE((huge_number1 <=> huge_number2) > 0);
+    EXPECT_TRUE((small_number <=> 9955) == 0);
+    EXPECT_TRUE((-5 <=> small_number) < 0);
+#endif
 }
 
 TEST(Test_BigInt, Pow_Tests) {
@@ -477,11 +500,29 @@ TEST(Test_BigInt, Log_Tests) {
     EXPECT_THROW(bigint::log10(0), std::domain_error);
     EXPECT_THROW(bigint::log10(-1), std::domain_error);
 
-    // logwithbase — floor(log_base(n)) via integer log2 division
+    // logwithbase — floor(log_base(n))
     EXPECT_EQ(bigint::logwithbase(8, 2), 3);
     EXPECT_EQ(bigint::logwithbase(100, 10), 2);
     EXPECT_EQ(bigint::logwithbase(1000, 10), 3);
     EXPECT_EQ(bigint::logwithbase(1024, 2), 10);
+    EXPECT_EQ(bigint::logwithbase(242, 3), 4);
+    EXPECT_EQ(bigint::logwithbase(243, 3), 5);
+
+    // ilog and bit_length — exact next to powers of the base
+    EXPECT_EQ(bigint::log2(bigint::pow(2, 40)), 40);
+    EXPECT_EQ(bigint::log2(bigint::pow(2, 40) - 1), 39);
+    EXPECT_EQ(bigint::ilog(bigint::pow(3, 5000), 3), 5000u);
+    EXPECT_EQ(bigint::ilog(bigint::pow(3, 5000) - 1, 3), 4999u);
+    EXPECT_EQ(bigint::ilog(bigint::pow(7, 300) + 1, 7), 300u);
+    EXPECT_EQ(bigint::ilog(std::string{kHugeB}, 10), 99u);
+    EXPECT_EQ(bigint::ilog(std::string{kHugeB}, bigint::pow(10, 33)), 3u);
+    EXPECT_EQ(bigint::ilog(5, bigint::pow(10, 20)), 0u);
+    EXPECT_THROW(bigint::ilog(0, 3), std::domain_error);
+    EXPECT_THROW(bigint::ilog(10, 1), std::domain_error);
+    EXPECT_EQ(bigint::bit_length(0), 0u);
+    EXPECT_EQ(bigint::bit_length(255), 8u);
+    EXPECT_EQ(bigint::bit_length(-256), 9u);
+    EXPECT_EQ(bigint::bit_length(bigint::pow(2, 1000)), 1001u);
 
     // antilog2 — 2^n
     EXPECT_EQ(bigint::antilog2(0), 1);
@@ -517,6 +558,1015 @@ TEST(Test_BigInt, Count_Tests) {
 
 }
 
+TEST(Test_BigInt, Bitwise_Tests) {
+    const bigint B{std::string{kHugeB}};
+
+    EXPECT_EQ(bigint(1) << 0, 1);
+    EXPECT_EQ(bigint(1) << 10, 1024);
+    EXPECT_EQ(bigint(3) << 64, "55340232221128654848");
+    EXPECT_EQ(bigint(0) << 1000, 0);
+    EXPECT_EQ(bigint(-5) << 3, -40);
+    EXPECT_EQ(B << 100, "12477705782429543105665439446516782527563166209942936317095387067084604155423620159836231584580751010147849924189405137484229115904");
+    EXPECT_EQ((B << 1000) >> 1000, B);
+
+    EXPECT_EQ(bigint(1024) >> 10, 1);
+    EXPECT_EQ(bigint(1023) >> 10, 0);
+    EXPECT_EQ(bigint(-5) >> 1, -3);
+    EXPECT_EQ(bigint(-1) >> 100, -1);
+    EXPECT_EQ(bigint(-1024) >> 10, -1);
+    EXPECT_EQ(B >> 77, "65136663433966818400798803680120947640197328354725540238058632293570495069785");
+    EXPECT_EQ(-B >> 77, "-65136663433966818400798803680120947640197328354725540238058632293570495069786");
+    EXPECT_EQ(B >> 1000, 0);
+
+    EXPECT_EQ(bigint(12) & 10, 8);
+    EXPECT_EQ(bigint(12) | 10, 14);
+    EXPECT_EQ(bigint(12) ^ 10, 6);
+    EXPECT_EQ(bigint(-12) & 10, 0);
+    EXPECT_EQ(bigint(-12) | 10, -2);
+    EXPECT_EQ(bigint(-12) ^ -10, 2);
+    EXPECT_EQ(~bigint(0), -1);
+    EXPECT_EQ(~bigint(-1), 0);
+    EXPECT_EQ(~B, -B - 1);
+    EXPECT_EQ(B & (B >> 3), "1093626406376205940929797288236625134546850694127425991374450097277108085662529946050059467699032080");
+    EXPECT_EQ(B | -(B >> 5), "-307599179121691991428109265959202264272205531688356740555558984676295582710455183287508585259599172");
+    EXPECT_EQ(B ^ (bigint(1) << 200), "9843174278608822755442867695930794030262240282875923952394068631713961515076753696834457714348570780");
+
+    EXPECT_TRUE(bigint::test_bit(5, 0));
+    EXPECT_FALSE(bigint::test_bit(5, 1));
+    EXPECT_TRUE(bigint::test_bit(bigint(1) << 300, 300));
+    EXPECT_FALSE(bigint::test_bit(bigint(1) << 300, 299));
+    EXPECT_TRUE(bigint::test_bit(-1, 1000));
+    EXPECT_FALSE(bigint::test_bit(-2, 0));
+    EXPECT_EQ(bigint::set_bit(0, 64), "18446744073709551616");
+    EXPECT_EQ(bigint::set_bit(5, 2), 5);
+    EXPECT_EQ(bigint::set_bit(-8, 0), -7);
+
+    EXPECT_EQ(bigint::popcount(0), 0);
+    EXPECT_EQ(bigint::popcount(255), 8);
+    EXPECT_EQ(bigint::popcount(-255), 8);
+    EXPECT_EQ(bigint::popcount(B), 148);
+
+    EXPECT_EQ(bigint::trailing_zeros(1), 0);
+    EXPECT_EQ(bigint::trailing_zeros(-96), 5);
+    EXPECT_EQ(bigint::trailing_zeros(bigint(1) << 200), 200);
+    EXPECT_EQ(bigint::trailing_zeros(bigint(3) << 40), 40);
+    EXPECT_THROW(bigint::trailing_zeros(0), std::domain_error);
+}
+
+TEST(Test_BigInt, Gcd_Tests) {
+    const bigint A{std::string{kHugeA}};
+    const bigint B{std::string{kHugeB}};
+
+    EXPECT_EQ(bigint::gcd(0, 0), 0);
+    EXPECT_EQ(bigint::gcd(0, 12), 12);
+    EXPECT_EQ(bigint::gcd(-12, 0), 12);
+    EXPECT_EQ(bigint::gcd(12, 18), 6);
+    EXPECT_EQ(bigint::gcd(-12, 18), 6);
+    EXPECT_EQ(bigint::gcd(17, 5), 1);
+    EXPECT_EQ(bigint::gcd(A, B), 3);
+    EXPECT_EQ(bigint::gcd(A * B * 7, B * B * 6 * bigint::pow(2, 69)), "29529522835826468266328603087792382090781900034494994886355580008864861057422694481522024764539808212");
+
+    EXPECT_EQ(bigint::lcm(4, 6), 12);
+    EXPECT_EQ(bigint::lcm(-4, 6), 12);
+    EXPECT_EQ(bigint::lcm(0, 6), 0);
+    EXPECT_EQ(bigint::lcm(A, B), "123840891218691514573979967715212111722889603497353169636639888435341536430530109465596521203969960652230691388298857407338308529760894969223941388464685065358571540852363285353228539423536105856136442613749597002442363725768342577932128541786201336657547611225200045144284067892785850166637001925179620253315463516560484416227097435797858676536801497158433162278143207257800126834860080122677612974511934835232445480020840446154993039489608135939989590082750336800894154057344372633325672573993992505217175449675989349083352737781179253959701181495233022436508745040933170824321103287169554155755204");
+
+    for (const auto& pair : std::vector<std::pair<bigint, bigint>>{{240, 46}, {-240, 46}, {240, -46}, {0, 5}, {A, B}, {B, A}}) {
+        const auto result = bigint::gcdext(pair.first, pair.second);
+        EXPECT_EQ(std::get<0>(result), bigint::gcd(pair.first, pair.second));
+        EXPECT_EQ(pair.first * std::get<1>(result) + pair.second * std::get<2>(result), std::get<0>(result));
+    }
+
+    EXPECT_EQ(bigint::modinv(3, 11), 4);
+    EXPECT_EQ(bigint::modinv(-3, 11), 7);
+    EXPECT_EQ(bigint::modinv(7, B), "2812335508173949358697962198837369722931609527094761417748150477034748672135494712525907120432362687");
+    EXPECT_EQ(bigint::modinv(B + 1, A), "32828243758651222786975127190494021477074543915535685348561258664913993140808582981051674699511848812230059392002688967193868404323052638823641329548105993948276317017985920314270892913824921162962365038609503694231778227343908927340608667283500541879626685987354977755226410370099425115257863506486913354292688242612105010717774324946090351320520350942965496740906263794646891811055306749778337049894514014061066213388814470122140166345937423075513503153595766096279924960942415988040108618029171713");
+    EXPECT_THROW(bigint::modinv(3, B), std::domain_error);
+    EXPECT_THROW(bigint::modinv(3, 0), std::domain_error);
+
+    EXPECT_EQ(bigint(-7) % 3, -1);
+    EXPECT_EQ(bigint(7) % -3, 1);
+    EXPECT_EQ(bigint(-7) % 2, -1);
+}
+
+TEST(Test_BigInt, Prime_Tests) {
+    EXPECT_FALSE(bigint::is_prime(-7));
+    EXPECT_FALSE(bigint::is_prime(0));
+    EXPECT_FALSE(bigint::is_prime(1));
+    EXPECT_TRUE(bigint::is_prime(2));
+    EXPECT_TRUE(bigint::is_prime(3));
+    EXPECT_FALSE(bigint::is_prime(4));
+    EXPECT_TRUE(bigint::is_prime(1999));
+    EXPECT_FALSE(bigint::is_prime(561));
+    EXPECT_TRUE(bigint::is_prime(4000037));
+    EXPECT_FALSE(bigint::is_prime(bigint(4000037) * 4000037));
+    EXPECT_TRUE(bigint::is_prime(1000000007));
+    EXPECT_TRUE(bigint::is_prime(1000000007, 10));
+
+    // Strong pseudoprime to every prime base up to 23, rejected by the Lucas half of Baillie-PSW
+    EXPECT_FALSE(bigint::is_prime(std::string{"3825123056546413051"}));
+
+    const bigint m61 = bigint::pow(2, 61) - 1;
+    const bigint m89 = bigint::pow(2, 89) - 1;
+    const bigint m521 = bigint::pow(2, 521) - 1;
+    EXPECT_TRUE(bigint::is_prime(m61));
+    EXPECT_TRUE(bigint::is_prime(m89));
+    EXPECT_TRUE(bigint::is_prime(m521, 5));
+    EXPECT_FALSE(bigint::is_prime(m61 * m89));
+    EXPECT_FALSE(bigint::is_prime(m89 * m89));
+    EXPECT_FALSE(bigint::is_prime(bigint::pow(2, 523) - 1));
+}
+
+TEST(Test_BigInt, Prime_Search_Tests) {
+    EXPECT_EQ(bigint::next_prime(-5), 2);
+    EXPECT_EQ(bigint::next_prime(2), 3);
+    EXPECT_EQ(bigint::next_prime(1999), 2003);
+    EXPECT_EQ(bigint::next_prime(100000), 100003);
+    EXPECT_EQ(bigint::next_prime(999999937), 1000000007);
+    EXPECT_EQ(bigint::next_prime(bigint::pow(10, 100)), bigint::pow(10, 100) + 267);
+    EXPECT_EQ(bigint::next_prime(bigint::pow(10, 100), 4), bigint::pow(10, 100) + 267);
+
+    EXPECT_THROW(bigint::prev_prime(2), std::domain_error);
+    EXPECT_EQ(bigint::prev_prime(3), 2);
+    EXPECT_EQ(bigint::prev_prime(2003), 1999);
+    EXPECT_EQ(bigint::prev_prime(100000), 99991);
+    EXPECT_EQ(bigint::prev_prime(1000000007), 999999937);
+    EXPECT_EQ(bigint::prev_prime(bigint::pow(10, 100), 0), bigint::pow(10, 100) - 797);
+
+    EXPECT_THROW(bigint::random_prime(1), std::domain_error);
+    EXPECT_EQ(bigint::random_prime(2) >> 1, 1);
+    for (const std::size_t bits : {16, 64, 256}) {
+        const bigint p = bigint::random_prime(bits, 2);
+        EXPECT_TRUE(bigint::is_prime(p));
+        EXPECT_EQ(p >> (bits - 1), 1);
+    }
+}
+
+TEST(Test_BigInt, Factorize_Tests) {
+    using factors = std::vector<std::pair<bigint, std::size_t>>;
+
+    EXPECT_THROW(bigint::factorize(0), std::domain_error);
+    EXPECT_EQ(bigint::factorize(1), factors{});
+    EXPECT_EQ(bigint::factorize(-360), (factors{{2, 3}, {3, 2}, {5, 1}}));
+    EXPECT_EQ(bigint::factorize(1000000007), (factors{{1000000007, 1}}));
+    EXPECT_EQ(bigint::factorize(bigint::pow(3, 40)), (factors{{3, 40}}));
+    EXPECT_EQ(bigint::factorize(600851475143), (factors{{71, 1}, {839, 1}, {1471, 1}, {6857, 1}}));
+
+    const bigint m61 = bigint::pow(2, 61) - 1;
+    EXPECT_EQ(bigint::factorize(m61 * m61 * 1000000007), (factors{{1000000007, 1}, {m61, 2}}));
+    EXPECT_EQ(bigint::factorize(bigint(std::string{"1000000000039"}) * std::string{"1000000000000037"}, 2),
+              (factors{{std::string{"1000000000039"}, 1}, {std::string{"1000000000000037"}, 1}}));
+}
+
+TEST(Test_BigInt, Factorial_Tests) {
+    EXPECT_EQ(bigint::factorial(0), 1);
+    EXPECT_EQ(bigint::factorial(1), 1);
+    EXPECT_EQ(bigint::factorial(20), 2432902008176640000);
+    EXPECT_EQ(bigint::factorial(30), "265252859812191058636308480000000");
+    EXPECT_EQ(bigint::factorial(1000) / bigint::factorial(999), 1000);
+    EXPECT_THROW(bigint::factorial(-1), std::runtime_error);
+
+    EXPECT_EQ(bigint::double_factorial(0), 1);
+    EXPECT_EQ(bigint::double_factorial(9), 945);
+    EXPECT_EQ(bigint::double_factorial(30), 42849873690624000);
+    EXPECT_EQ(bigint::double_factorial(101) * bigint::double_factorial(100), bigint::factorial(101));
+
+    EXPECT_EQ(bigint::primorial(1), 1);
+    EXPECT_EQ(bigint::primorial(2), 2);
+    EXPECT_EQ(bigint::primorial(10), 210);
+    EXPECT_EQ(bigint::primorial(50), 614889782588491410);
+
+    EXPECT_EQ(bigint::binomial(5, 0), 1);
+    EXPECT_EQ(bigint::binomial(5, 2), 10);
+    EXPECT_EQ(bigint::binomial(5, 7), 0);
+    EXPECT_EQ(bigint::binomial(100, 50), "100891344545564193334812497256");
+    EXPECT_EQ(bigint::binomial(bigint::pow(10, 30), 3), "166666666666666666666666666666166666666666666666666666666667000000000000000000000000000000");
+    EXPECT_THROW(bigint::binomial(-5, 2), std::domain_error);
+
+    const std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25};
+    EXPECT_EQ(bigint::product(values.begin(), values.end()), "15511210043330985984000000");
+    EXPECT_EQ(bigint::product(values.begin(), values.begin()), 1);
+    const std::vector<bigint> big_values = {bigint{std::string{kHugeA}}, bigint{std::string{kHugeB}}, -1};
+    EXPECT_EQ(bigint::product(big_values.begin(), big_values.end()), bigint("-" + std::string{AmulB}));
+}
+
+TEST(Test_BigInt, Fibonacci_Tests) {
+    EXPECT_EQ(bigint::fibonacci(0), 0);
+    EXPECT_EQ(bigint::fibonacci(1), 1);
+    EXPECT_EQ(bigint::fibonacci(2), 1);
+    EXPECT_EQ(bigint::fibonacci(10), 55);
+    EXPECT_EQ(bigint::fibonacci(100), "354224848179261915075");
+    EXPECT_EQ(bigint::fibonacci(1000), "43466557686937456435688527675040625802564660517371780402481729089536555417949051890403879840079255169295922593080322634775209689623239873322471161642996440906533187938298969649928516003704476137795166849228875");
+    EXPECT_EQ(bigint::fibonacci(-7), 13);
+    EXPECT_EQ(bigint::fibonacci(-8), -21);
+    EXPECT_EQ(bigint::count_digits(bigint::fibonacci(10000)), 2090);
+
+    EXPECT_EQ(bigint::lucas(0), 2);
+    EXPECT_EQ(bigint::lucas(1), 1);
+    EXPECT_EQ(bigint::lucas(10), 123);
+    EXPECT_EQ(bigint::lucas(300), "496926405783746676393791436882468230898067489522034699520200002");
+    EXPECT_EQ(bigint::lucas(-7), -29);
+    EXPECT_EQ(bigint::lucas(-8), 47);
+
+    const bigint n = 4321;
+    EXPECT_EQ(bigint::fibonacci(n * 2), bigint::fibonacci(n) * bigint::lucas(n));
+
+    EXPECT_EQ(bigint::linear_recurrence(1, 1, 0, 1, 1000), bigint::fibonacci(1000));
+    EXPECT_EQ(bigint::linear_recurrence(1, 1, 2, 1, 300), bigint::lucas(300));
+    EXPECT_EQ(bigint::linear_recurrence(2, 1, 0, 1, 50), 4866752642924153522);
+    EXPECT_EQ(bigint::linear_recurrence(3, -2, 0, 1, 100), bigint::pow(2, 100) - 1);
+
+    const auto power = bigint::matrix_pow({{1, 1, 1, 0}}, 100);
+    EXPECT_EQ(power[1], bigint::fibonacci(100));
+    EXPECT_EQ(power[0], bigint::fibonacci(101));
+    EXPECT_EQ(bigint::matrix_pow({{5, 7, 11, 13}}, 0)[0], 1);
+    EXPECT_THROW(bigint::matrix_pow({{1, 1, 1, 0}}, -1), std::domain_error);
+
+    const bigint big{std::string{kHugeA}};
+    EXPECT_EQ(big * big, big * bigint(big + 1) - big);
+}
+
+TEST(Test_BigInt, Power_Cache_Tests) {
+    const auto limit = bigint::power_cache_limit();
+    EXPECT_EQ(bigint::pow(3, 200), "265613988875874769338781322035779626829233452653394495974574961739092490901302182994384699044001");
+    EXPECT_EQ(bigint::pow(-7, 33), "-7730993719707444524137094407");
+    EXPECT_EQ(bigint::pow(-7, 32), bigint::pow(7, 32));
+    EXPECT_EQ(bigint::pow(999999999, 5), "999999995000000009999999990000000004999999999");
+    EXPECT_EQ(bigint::pow(2, 1024), bigint(1) << 1024);
+    EXPECT_EQ(bigint::pow10(0), 1);
+    EXPECT_EQ(bigint::pow10(20), "100000000000000000000");
+    EXPECT_EQ(bigint::count_digits(bigint::pow10(1000)), 1001);
+
+    const bigint expected = bigint::pow(3, 4096);
+    bigint::set_power_cache_limit(0);
+    EXPECT_EQ(bigint::power_cache_limit(), 0u);
+    EXPECT_EQ(bigint::pow(3, 4096), expected);
+    bigint::set_power_cache_limit(limit);
+    bigint::clear_power_cache();
+
+    std::vector<std::future<bigint>> results;
+    for (int i = 0; i < 4; ++i) {
+        results.push_back(std::async(std::launch::async, [] { return bigint::pow(3, 4096); }));
+    }
+    for (auto& result : results) {
+        EXPECT_EQ(result.get(), expected);
+    }
+    EXPECT_EQ(bigint::ilog(expected, 3), 4096u);
+}
+
+TEST(Test_BigInt, Radix_Conversion_Tests) {
+    EXPECT_EQ(bigint::to_hex(0), "0x0");
+    EXPECT_EQ(bigint::to_hex(255), "0xff");
+    EXPECT_EQ(bigint::to_hex(-48879), "-0xbeef");
+    EXPECT_EQ(bigint::to_hex(bigint("0xDEADBEEF0FF1CEF0CACC1A")), "0xdeadbeef0ff1cef0cacc1a");
+    EXPECT_EQ(bigint::to_binary(0), "0b0");
+    EXPECT_EQ(bigint::to_binary(12345), "0b11000000111001");
+    EXPECT_EQ(bigint::to_binary(-1), "-0b1");
+    EXPECT_EQ(bigint("0b11000000111001"), 12345);
+    EXPECT_EQ(bigint("-0b101"), -5);
+    EXPECT_THROW(bigint("0b102"), std::runtime_error);
+
+    const bigint huge{std::string{kHugeA}};
+    const std::string hex = bigint::to_hex(huge);
+    EXPECT_EQ(hex.size(), 417u);
+    EXPECT_EQ(hex.substr(0, 20), "0xbc7e70909499aa7df7");
+    EXPECT_EQ(bigint(hex), huge);
+    EXPECT_EQ(bigint(bigint::to_binary(huge)), huge);
+    const std::string power_hex = bigint::to_hex(bigint::pow(3, 5000));
+    EXPECT_EQ(power_hex.substr(power_hex.size() - 20), "73117631e29921b46fa1");
+
+    // Long enough to take the divide-and-conquer path in both directions
+    std::string digits = "0x";
+    for (int i = 0; i < 20000; ++i) digits += "0123456789abcdef"[(i * 7 + i / 3 + 1) % 16];
+    const bigint parsed{digits};
+    EXPECT_EQ(bigint::to_hex(parsed), digits);
+    EXPECT_EQ(parsed, (parsed >> 40000) << 40000 | (parsed & ((bigint(1) << 40000) - 1)));
+    EXPECT_EQ(bigint::to_hex(-parsed), "-" + digits);
+}
+
+TEST(Test_BigInt, From_Chars_Tests) {
+    const std::string text = "x-123456789012345678901234567890y";
+    EXPECT_EQ(bigint::from_chars(text.data() + 1, text.data() + text.size() - 1), "-123456789012345678901234567890");
+    EXPECT_EQ(bigint::from_chars(text.data() + 2, text.data() + 11), 123456789);
+    EXPECT_EQ(bigint::from_chars(text.data() + 2, text.data() + 3), 1);
+    EXPECT_THROW(bigint::from_chars(text.data(), text.data() + text.size()), std::runtime_error);
+    EXPECT_THROW(bigint::from_chars(text.data() + 1, text.data() + 1), std::runtime_error);
+
+    const std::string_view view{"9876543210987654321098765432100000"};
+    EXPECT_EQ(bigint(view), "9876543210987654321098765432100000");
+    EXPECT_EQ(bigint(view.substr(0, 10)), 9876543210);
+    EXPECT_EQ(bigint(std::string_view{"-0xff"}), -255);
+    EXPECT_EQ(bigint(std::string_view{"0b1010"}), 10);
+    EXPECT_EQ(bigint(std::string{kHugeA}), bigint(kHugeA));
+
+    for (const char* invalid : {"", "-", "-0", "00", "012", "0x", "-0x0", "0b", "0b12", "+1", "1-", "12345678901234567a9", "1234567890123456789 "}) {
+        EXPECT_THROW(bigint(std::string_view{invalid}), std::runtime_error) << invalid;
+        EXPECT_THROW(bigint::from_chars(invalid, invalid + std::strlen(invalid)), std::runtime_error) << invalid;
+    }
+}
+
+TEST(Test_BigInt, To_Chars_Tests) {
+    char buffer[64];
+    const bigint value{"-12345678901234567890"};
+    EXPECT_EQ(bigint::formatted_size(value), 21u);
+    auto result = bigint::to_chars(buffer, buffer + sizeof(buffer), value);
+    EXPECT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "-12345678901234567890");
+
+    result = bigint::to_chars(buffer, buffer + 20, value);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    EXPECT_EQ(result.ptr, buffer + 20);
+
+    result = bigint::to_chars(buffer, buffer + 1, 0);
+    EXPECT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "0");
+    EXPECT_EQ(bigint::formatted_size(1000000000), 10u);
+    EXPECT_EQ(std::string(bigint(1000000000)), "1000000000");
+    EXPECT_EQ(std::string(bigint(-999999999)), "-999999999");
+
+    const bigint huge{std::string{kHugeA}};
+    std::string formatted(bigint::formatted_size(huge), ' ');
+    bigint::to_chars(&formatted[0], &formatted[0] + formatted.size(), huge, 0);
+    EXPECT_EQ(formatted, kHugeA);
+
+    // Large enough for several parallel chunks
+    std::string digits(1300000, '0');
+    for (std::size_t i = 0; i < digits.size(); ++i) digits[i] = static_cast<char>('1' + i * 7 % 9);
+    const bigint big{digits};
+    std::string parallel(bigint::formatted_size(big), ' ');
+    result = bigint::to_chars(&parallel[0], &parallel[0] + parallel.size(), big, 4);
+    EXPECT_EQ(result.ptr, &parallel[0] + parallel.size());
+    EXPECT_EQ(parallel, digits);
+
+    // Gigadigit sizes overflow int; the count is exact in std::size_t without allocating the value
+    const std::size_t limbs = static_cast<std::size_t>(std::numeric_limits<int>::max()) / 9 + 2;
+    const std::size_t expected = (limbs - 1) * 9 + 3;
+    EXPECT_GT(expected, static_cast<std::size_t>(std::numeric_limits<int>::max()));
+    EXPECT_EQ(bigint::decimal_digits(limbs, 123), expected);
+    EXPECT_EQ(bigint::decimal_digits(1, 0), 1u);
+    EXPECT_EQ(bigint::decimal_digits(2, 999999999), 18u);
+}
+
+TEST(Test_BigInt, Serialization_Tests) {
+    std::vector<std::uint8_t> buffer;
+    bigint::serialize(300, buffer);
+    EXPECT_EQ(buffer, (std::vector<std::uint8_t>{0x10, 0xAC, 0x02}));
+    bigint::serialize(-5, buffer);
+    bigint::serialize(bigint::pow(10, 18), buffer);
+    EXPECT_EQ(buffer.size(), 3u + 2u + 14u);
+    EXPECT_EQ(buffer[5], 0x12);
+    EXPECT_EQ(buffer[6], 3);
+    EXPECT_EQ(buffer[7], 1);
+    EXPECT_EQ(bigint::serialized_size(bigint::pow(10, 18)), 14u);
+
+    const bigint huge{std::string{kHugeA}};
+    bigint::serialize(-huge, buffer);
+    bigint::serialize(0, buffer);
+    EXPECT_EQ(buffer.size(), 19u + bigint::serialized_size(huge) + 2u);
+
+    const std::uint8_t* cursor = buffer.data();
+    const std::uint8_t* const end = buffer.data() + buffer.size();
+    EXPECT_EQ(bigint::deserialize(cursor, end), 300);
+    EXPECT_EQ(bigint::deserialize(cursor, end), -5);
+    EXPECT_EQ(bigint::deserialize(cursor, end), bigint::pow(10, 18));
+    const auto view = BigInt::bigint_view::parse(cursor, end);
+    EXPECT_TRUE(view.is_negative());
+    EXPECT_EQ(view.size(), 56u);
+    EXPECT_EQ(view.limb(0), 37744u);
+    EXPECT_EQ(view.to_bigint(), -huge);
+    EXPECT_EQ(bigint::deserialize(cursor, end), 0);
+    EXPECT_EQ(cursor, end);
+
+    // Truncated, unknown version, non-canonical limbs and negative zero are rejected
+    const std::vector<std::vector<std::uint8_t>> malformed = {
+        {}, {0x10}, {0x10, 0x80}, {0x20, 0x01}, {0x11, 0x00}, {0x12, 0x02, 0, 0, 0, 0, 1, 0, 0, 0},
+        {0x12, 0x01, 0x00, 0xCA, 0x9A, 0x3B}, {0x12, 0x02, 1, 0, 0, 0}};
+    for (const auto& bytes : malformed) {
+        const std::uint8_t* first = bytes.data();
+        EXPECT_THROW(bigint::deserialize(first, bytes.data() + bytes.size()), std::runtime_error);
+    }
+}
+
+TEST(Test_BigInt, Stream_Input_Tests) {
+    std::istringstream input("  123456789012345678901234567890 -42\n0xff -0b101 0 1234567890abc");
+    bigint value;
+    input >> value;
+    EXPECT_EQ(value, "123456789012345678901234567890");
+    input >> value;
+    EXPECT_EQ(value, -42);
+    input >> value;
+    EXPECT_EQ(value, 255);
+    input >> value;
+    EXPECT_EQ(value, -5);
+    input >> value;
+    EXPECT_EQ(value, 0);
+    input >> value;
+    EXPECT_EQ(value, 1234567890);
+    std::string rest;
+    input >> rest;
+    EXPECT_EQ(rest, "abc");
+    EXPECT_FALSE(input >> value);
+
+    for (const char* invalid : {"-", "-0", "012", "0x", "x1"}) {
+        std::istringstream bad(invalid);
+        bad >> value;
+        EXPECT_TRUE(bad.fail()) << invalid;
+    }
+
+    std::ostringstream text;
+    const bigint huge{std::string{kHugeA}};
+    text << huge << "\n" << -huge << "\t" << bigint::to_hex(huge) << " 7\n";
+    std::istringstream chunked(text.str());
+    BigInt::bigint_reader reader(chunked, 16);
+    EXPECT_TRUE(reader.read(value));
+    EXPECT_EQ(value, huge);
+    EXPECT_TRUE(reader.read(value));
+    EXPECT_EQ(value, -huge);
+    EXPECT_TRUE(reader.read(value));
+    EXPECT_EQ(value, huge);
+    EXPECT_TRUE(reader.read(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(reader.read(value));
+
+    std::istringstream malformed("12 3x4");
+    BigInt::bigint_reader strict(malformed);
+    EXPECT_TRUE(strict.read(value));
+    EXPECT_THROW(strict.read(value), std::runtime_error);
+
+#ifdef BIGINT_POSIX
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    const std::string contents = text.str();
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fflush(file);
+    std::rewind(file);
+    BigInt::bigint_reader fd_reader(fileno(file), 64);
+    EXPECT_TRUE(fd_reader.read(value));
+    EXPECT_EQ(value, huge);
+    std::fclose(file);
+#endif
+}
+
+TEST(Test_BigInt, Mapped_File_Tests) {
+    const std::string path = ::testing::TempDir() + "bigint_mapped_file_test.bin";
+    const bigint huge = -bigint::pow(bigint{std::string{kHugeA}}, 20);
+
+    bigint::save_file(huge, path);
+    std::vector<std::uint8_t> expected;
+    bigint::serialize(huge, expected);
+    std::ifstream saved(path, std::ios::binary);
+    const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(saved), std::istreambuf_iterator<char>()};
+    EXPECT_EQ(bytes, expected);
+
+    auto mapped = bigint::map_file(path);
+    EXPECT_TRUE(mapped.view().is_negative());
+    EXPECT_EQ(mapped.view().size(), bigint::serialized_size(huge) / 4);
+    const auto moved = std::move(mapped);
+    EXPECT_EQ(moved.to_bigint(), huge);
+
+    bigint::save_file(12345, path);
+    EXPECT_EQ(bigint::map_file(path).to_bigint(), 12345);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a bigint";
+    EXPECT_THROW(bigint::map_file(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(bigint::map_file(path), std::runtime_error);
+}
+
+TEST(Test_BigInt, Streaming_File_Tests) {
+    const std::string a_path = ::testing::TempDir() + "bigint_stream_a.bin";
+    const std::string b_path = ::testing::TempDir() + "bigint_stream_b.bin";
+    const std::string out_path = ::testing::TempDir() + "bigint_stream_out.bin";
+    const auto result = [&out_path] { return bigint::map_file(out_path).to_bigint(); };
+
+    // Operands spanning several output chunks, including borrows that run the whole length
+    std::mt19937_64 engine(17);
+    const bigint big = bigint::random_digits(200000, engine);
+    const bigint power = bigint::pow10(180000);
+    const std::vector<bigint> values{big, -big, big + 1, power, power - 1, bigint::random_digits(150000, engine), 7, -5, 0};
+    for (const auto& a : values) {
+        bigint::save_file(a, a_path);
+        const auto lhs = bigint::map_file(a_path);
+        for (const auto& b : {big, power - 1, -power, bigint(3), bigint(0)}) {
+            bigint::save_file(b, b_path);
+            const auto rhs = bigint::map_file(b_path);
+            bigint::add_to_file(lhs.view(), rhs.view(), out_path);
+            ASSERT_EQ(result(), a + b);
+            bigint::subtract_to_file(lhs.view(), rhs.view(), out_path);
+            ASSERT_EQ(result(), a - b);
+            EXPECT_EQ(bigint::compare(lhs.view(), rhs.view()), a < b ? -1 : (a > b ? 1 : 0));
+        }
+        for (const long long factor : {0LL, 1LL, -7LL, 999999999LL}) {
+            bigint::multiply_to_file(lhs.view(), factor, out_path);
+            ASSERT_EQ(result(), a * factor);
+        }
+        for (const long long divisor : {1LL, 7LL, -3LL, 999999999LL}) {
+            const long long remainder = bigint::divide_to_file(lhs.view(), divisor, out_path);
+            ASSERT_EQ(result(), a / divisor);
+            EXPECT_EQ(bigint(remainder), a % divisor);
+        }
+    }
+
+    // Results are stored the way save_file stores them
+    bigint::save_file(power - 1, a_path);
+    bigint::save_file(-(power - 2), b_path);
+    bigint::add_to_file(bigint::map_file(a_path).view(), bigint::map_file(b_path).view(), out_path);
+    std::ifstream saved(out_path, std::ios::binary);
+    const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(saved), std::istreambuf_iterator<char>()};
+    std::vector<std::uint8_t> expected;
+    bigint::serialize(1, expected);
+    EXPECT_EQ(bytes, expected);
+
+    const auto lhs = bigint::map_file(a_path);
+    EXPECT_THROW(bigint::divide_to_file(lhs.view(), 0, out_path), std::domain_error);
+    EXPECT_THROW(bigint::multiply_to_file(lhs.view(), 1000000000LL, out_path), std::domain_error);
+    std::remove(a_path.c_str());
+    std::remove(b_path.c_str());
+    std::remove(out_path.c_str());
+}
+
+TEST(Test_BigInt, Arbitrary_Radix_Tests) {
+    EXPECT_EQ(bigint::to_string(0, 7), "0");
+    EXPECT_EQ(bigint::to_string(-123456789, 36), "-21i3v9");
+    EXPECT_EQ(bigint::to_string(255, 32), "7v");
+    EXPECT_EQ(bigint::to_string(bigint(1) << 64, 3), "11112220022122120101211020120210210211221");
+    EXPECT_EQ(bigint::to_string(8, 8), "10");
+    EXPECT_EQ(bigint::to_string(bigint{"123456789012345678901234567890"}, 10), "123456789012345678901234567890");
+
+    EXPECT_EQ(bigint::from_string("-21I3V9", 36), -123456789);
+    EXPECT_EQ(bigint::from_string("777", 8), 511);
+    EXPECT_EQ(bigint::from_string("0000", 5), 0);
+    EXPECT_THROW(bigint::from_string("-0", 3), std::runtime_error);
+    EXPECT_THROW(bigint::from_string("-000", 16), std::runtime_error);
+    EXPECT_EQ(bigint::from_string("11112220022122120101211020120210210211221", 3), bigint(1) << 64);
+    EXPECT_THROW(bigint::from_string("128", 8), std::runtime_error);
+    EXPECT_THROW(bigint::from_string("", 16), std::runtime_error);
+    EXPECT_THROW(bigint::from_string("z", 35), std::runtime_error);
+    EXPECT_THROW(bigint::to_string(10, 1), std::domain_error);
+    EXPECT_THROW(bigint::from_string("10", 37), std::domain_error);
+
+    const bigint huge{std::string{kHugeA}};
+    const std::string base36 = bigint::to_string(huge, 36);
+    EXPECT_EQ(base36.size(), 322u);
+    EXPECT_EQ(base36.substr(0, 30), "10b8bms4f4wg57611hlvujxwtq9byf");
+    const std::string base7 = bigint::to_string(-huge, 7);
+    EXPECT_EQ(base7.size(), 593u);
+    EXPECT_EQ(base7.substr(base7.size() - 30), "045411565462155405311464443030");
+    EXPECT_EQ(bigint::to_string(huge, 8).substr(0, 30), "136176341102244632517575677673");
+
+    // Long values take the divide-and-conquer paths
+    const bigint big = bigint::pow(huge, 12);
+    for (int base = 2; base <= 36; ++base) {
+        EXPECT_EQ(bigint::from_string(bigint::to_string(big, base), base), big) << base;
+    }
+
+    // Large enough that the splits divide through Newton reciprocals
+    std::mt19937_64 engine(11);
+    const bigint large = bigint::random_digits(60000, engine);
+    EXPECT_EQ(bigint::from_string(bigint::to_string(large, 36), 36), large);
+    EXPECT_EQ(bigint::from_string(bigint::to_string(-large, 7), 7), -large);
+}
+
+TEST(Test_BigInt, Word_Import_Export_Tests) {
+    using byte_order = bigint::byte_order;
+    using word_order = bigint::word_order;
+    const bigint value{"6495562832581790741585804755439063472350678237"};  // 0x0123456789abcdeffedcba9876543210aabbccdd
+
+    const std::uint64_t little_words[] = {0x76543210aabbccddULL, 0x89abcdeffedcba98ULL, 0x01234567ULL};
+    EXPECT_EQ(bigint::import_words(little_words, 3, 8), value);
+    const std::uint64_t big_order[] = {0x01234567ULL, 0x89abcdeffedcba98ULL, 0x76543210aabbccddULL};
+    EXPECT_EQ(bigint::import_words(big_order, 3, 8, byte_order::native, word_order::most_significant_first), value);
+
+    const unsigned char big_endian[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc,
+                                        0xba, 0x98, 0x76, 0x54, 0x32, 0x10, 0xaa, 0xbb, 0xcc, 0xdd};
+    EXPECT_EQ(bigint::import_words(big_endian, 20, 1, byte_order::big, word_order::most_significant_first), value);
+    EXPECT_EQ(bigint::import_words(big_endian, 5, 4, byte_order::big, word_order::most_significant_first), value);
+    EXPECT_EQ(bigint::import_words(big_endian, 0, 4), 0);
+    EXPECT_EQ(bigint::import_words(nullptr, 0, 4), 0);
+
+    EXPECT_EQ(bigint::export_size(value, 8), 3u);
+    EXPECT_EQ(bigint::export_size(value, 1), 20u);
+    EXPECT_EQ(bigint::export_size(0, 8), 0u);
+    unsigned char bytes[20] = {};
+    EXPECT_EQ(bigint::export_words(-value, bytes, 20, 1, byte_order::big, word_order::most_significant_first), 20u);
+    EXPECT_TRUE(std::equal(bytes, bytes + 20, big_endian));
+    std::uint64_t words[3] = {};
+    EXPECT_EQ(bigint::export_words(value, words, 3, 8), 3u);
+    EXPECT_EQ(words[0], little_words[0]);
+    EXPECT_EQ(words[2], 0x01234567ULL);
+    EXPECT_THROW(bigint::export_words(value, words, 2, 8), std::length_error);
+    // Zero exports no words and, as with mpz_export, never touches the buffer
+    EXPECT_EQ(bigint::export_words(0, words, 3, 8), 0u);
+    EXPECT_EQ(bigint::export_words(0, nullptr, 0, 4), 0u);
+    EXPECT_EQ(bigint::export_words(0, nullptr, 0, 1, byte_order::big, word_order::most_significant_first), 0u);
+
+    const bigint huge{std::string{kHugeA}};
+    for (const std::size_t size : {1, 2, 3, 4, 8, 16}) {
+        for (const auto endian : {byte_order::little, byte_order::big}) {
+            for (const auto order : {word_order::least_significant_first, word_order::most_significant_first}) {
+                std::vector<unsigned char> buffer(bigint::export_size(huge, size) * size);
+                const auto count = bigint::export_words(huge, buffer.data(), buffer.size() / size, size, endian, order);
+                EXPECT_EQ(bigint::import_words(buffer.data(), count, size, endian, order), huge) << size;
+            }
+        }
+    }
+}
+
+TEST(Test_BigInt, Fixed_Width_Tests) {
+    using BigInt::uint128;
+    using BigInt::uint256;
+    using checked128 = BigInt::fixed_bigint<128, BigInt::checked_overflow>;
+
+    static_assert(sizeof(uint256) == 32, "fixed_bigint keeps its words inline");
+    constexpr uint256 zero;
+    EXPECT_EQ(zero, uint256(0));
+
+    const bigint modulus = bigint(1) << 256;
+    const bigint a{std::string{kHugeB}};
+    const bigint b = bigint{std::string{kHugeA}} % modulus;
+    const uint256 fa(a), fb(b);
+    EXPECT_EQ(fa.to_bigint(), a % modulus);
+    EXPECT_EQ((fa + fb).to_bigint(), (a + b) % modulus);
+    EXPECT_EQ((fb - fa).to_bigint(), (b - a % modulus + modulus) % modulus);
+    EXPECT_EQ((fa * fb).to_bigint(), (a % modulus) * b % modulus);
+    EXPECT_EQ((fb / uint256(12345)).to_bigint(), b / 12345);
+    EXPECT_EQ((fb % uint256(12345)).to_bigint(), b % 12345);
+    EXPECT_EQ((fb >> 100).to_bigint(), b >> 100);
+    EXPECT_EQ((fb << 100).to_bigint(), (b << 100) % modulus);
+    EXPECT_EQ((fa & fb).to_bigint(), (a % modulus) & b);
+    EXPECT_EQ(-uint256(1), uint256::max());
+    EXPECT_EQ(uint256(bigint(-1)), uint256::max());
+    EXPECT_EQ(uint128::max() + 1, uint128(0));
+    EXPECT_TRUE(uint256(5) < uint256(7));
+    EXPECT_TRUE(fa != fb);
+    EXPECT_THROW(fa / uint256(0), std::domain_error);
+
+    EXPECT_THROW(checked128::max() + 1, std::overflow_error);
+    EXPECT_THROW(checked128(3) - checked128(5), std::overflow_error);
+    EXPECT_THROW((checked128(1) << 64) * (checked128(1) << 64), std::overflow_error);
+    EXPECT_THROW(checked128(bigint(1) << 128), std::overflow_error);
+    EXPECT_THROW(checked128(bigint(-1)), std::overflow_error);
+    EXPECT_EQ((checked128(1) << 63) * (checked128(1) << 64), checked128(1) << 127);
+
+    // Mixed expressions are evaluated in bigint
+    const uint256 small(1000);
+    EXPECT_EQ(small + bigint(-2000), -1000);
+    EXPECT_EQ(bigint(-2000) + small, -1000);
+    EXPECT_EQ(small * modulus, modulus * 1000);
+    EXPECT_TRUE(small == bigint(1000));
+    EXPECT_TRUE(bigint(999) < small);
+}
+
+TEST(Test_BigInt, Literal_Tests) {
+    using namespace BigInt::literals;
+    using BigInt::uint256;
+
+    EXPECT_EQ(0_big, 0);
+    EXPECT_EQ(123456789_big, 123456789);
+    EXPECT_EQ(1000000000_big, bigint("1000000000"));
+    EXPECT_EQ(-987654321987654321987654321_big, bigint("-987654321987654321987654321"));
+    EXPECT_EQ(1'000'000'000'000_big, bigint("1000000000000"));
+    EXPECT_EQ(0xDeadBeefCafe0123456789_big, bigint("0xdeadbeefcafe0123456789"));
+    EXPECT_EQ(0b1011'0000'1111_big, 0xB0F);
+    EXPECT_EQ(0777_big, 511);
+    EXPECT_EQ(340282366920938463463374607431768211456_big, bigint(1) << 128);
+
+    // Fixed-width literals are constant expressions sized to their value
+    constexpr auto p = 340282366920938463463374607431768211507_fixed;
+    static_assert(sizeof(p) == 20, "a 129-bit literal takes five words");
+    static_assert(sizeof(7_fixed) == 4, "small literals take one word");
+    constexpr uint256 q{0xFFFF'FFFF'FFFF'FFFF'FFFF'FFFF'FFFF'FFFF_fixed};
+    constexpr uint256 r = q * q % uint256(1'000'000'007_fixed);
+    static_assert(r == uint256(233580713), "reduced at compile time");
+    static_assert(uint256(p) > q, "widening keeps the value");
+    EXPECT_EQ(p.to_bigint(), (bigint(1) << 128) + 51);
+    EXPECT_EQ(r.to_bigint(), ((bigint(1) << 128) - 1) * ((bigint(1) << 128) - 1) % 1000000007);
+}
+
+TEST(Test_BigInt, Batch_Tests) {
+    // Mixed sizes and signs, enough elements to be spread over the pool
+    std::vector<bigint> a, b;
+    const bigint huge{std::string{kHugeA}};
+    for (int i = 0; i < 1000; ++i) {
+        bigint x = i % 7 == 0 ? huge * (i + 1) : bigint(i * 7919 + 1) * (i % 3 == 0 ? huge : bigint(i));
+        bigint y = i % 5 == 0 ? bigint(999999999 - i) : bigint(i + 1) * (i % 2 == 0 ? huge : bigint(123456789));
+        if (i % 4 == 1) x = -x;
+        if (i % 6 == 2) y = -y;
+        a.push_back(x);
+        b.push_back(y);
+    }
+    a[3] = 0;
+    b[4] = -a[4];
+
+    std::vector<bigint> out(a.size());
+    bigint::batch_add(a.data(), b.data(), out.data(), a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(out[i], a[i] + b[i]);
+    EXPECT_FALSE(bigint::is_negative(out[4]));
+
+    bigint::batch_mul(a.data(), b.data(), out.data(), a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(out[i], a[i] * b[i]);
+
+    bigint::batch_mod(a.data(), b.data(), out.data(), a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(out[i], a[i] % b[i]);
+
+    const bigint modulus("1000000000000000000000000000057");
+    bigint::batch_mod(a.data(), modulus, out.data(), a.size(), 2);
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(out[i], a[i] % modulus);
+    bigint::batch_mod(a.data(), bigint(97), out.data(), a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(out[i], a[i] % 97);
+
+    // Results may be written over an operand
+    std::vector<bigint> squares = a;
+    bigint::batch_mul(squares.data(), squares.data(), squares.data(), squares.size());
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(squares[i], a[i] * a[i]);
+    std::vector<bigint> sums = a;
+    bigint::batch_add(sums.data(), b.data(), sums.data(), 10, 1);
+    for (std::size_t i = 0; i < 10; ++i) EXPECT_EQ(sums[i], a[i] + b[i]);
+
+    std::vector<bigint> zeros(a.size());
+    EXPECT_THROW(bigint::batch_mod(a.data(), zeros.data(), out.data(), a.size()), std::domain_error);
+    EXPECT_THROW(bigint::batch_mod(a.data(), bigint(0), out.data(), a.size()), std::domain_error);
+#if __cplusplus >= 202002L
+    std::vector<bigint> spans(a.size());
+    bigint::batch_mul(std::span<const bigint>(a), std::span<const bigint>(b), std::span<bigint>(spans));
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(spans[i], a[i] * b[i]);
+    bigint::batch_mod(std::span<const bigint>(a), modulus, std::span<bigint>(spans), 2);
+    for (std::size_t i = 0; i < a.size(); ++i) EXPECT_EQ(spans[i], a[i] % modulus);
+    EXPECT_THROW(bigint::batch_add(std::span<const bigint>(a), std::span<const bigint>(b).first(10), std::span<bigint>(spans)),
+                 std::invalid_argument);
+#endif
+}
+
+TEST(Test_BigInt, Bigint_Array_Tests) {
+    const bigint huge{std::string{kHugeA}};
+    std::vector<bigint> values;
+    for (int i = 0; i < 300; ++i) {
+        bigint value = i % 3 == 0 ? huge * (i + 1) : bigint(i * 1000003);
+        if (i % 4 == 1) value = -value;
+        values.push_back(value);
+    }
+    values.push_back(0);
+
+    bigint_array array(values.begin(), values.end());
+    ASSERT_EQ(array.size(), values.size());
+    std::size_t limbs = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(array[i].to_bigint(), values[i]);
+        EXPECT_EQ(array[i].hash(), std::hash<bigint>()(values[i]));
+        limbs += array[i].size();
+    }
+    EXPECT_EQ(array.limb_count(), limbs);
+    EXPECT_EQ(array[3].data() + array[3].size(), array[4].data());
+    EXPECT_EQ(array[0].is_negative(), false);
+    EXPECT_EQ(array[1].is_negative(), true);
+    EXPECT_THROW(array.at(values.size()), std::out_of_range);
+
+    // Serialization walks the arena and matches bigint::serialize element by element
+    std::vector<std::uint8_t> bytes, expected;
+    array.serialize(bytes);
+    for (const auto& value : values) bigint::serialize(value, expected);
+    EXPECT_EQ(bytes, expected);
+    const bigint_array decoded = bigint_array::deserialize(bytes.data(), bytes.data() + bytes.size());
+    EXPECT_EQ(decoded.hash(), array.hash());
+    EXPECT_EQ(std::hash<bigint_array>()(decoded), std::hash<bigint_array>()(array));
+
+    bigint_array sorted = array;
+    sorted.sort();
+    std::sort(values.begin(), values.end());
+    for (std::size_t i = 0; i < values.size(); ++i) EXPECT_EQ(sorted[i].to_bigint(), values[i]);
+    for (std::size_t i = 1; i < values.size(); ++i) EXPECT_EQ(sorted[i - 1].data() + sorted[i - 1].size(), sorted[i].data());
+    EXPECT_NE(sorted.hash(), array.hash());
+
+    // Batch kernels over two arrays
+    std::vector<bigint> divisors;
+    for (std::size_t i = 0; i < values.size(); ++i) divisors.push_back(i % 2 == 0 ? bigint(97 + i) : huge - i);
+    const bigint_array b(divisors.begin(), divisors.end());
+    const bigint_array sums = bigint::batch_add(sorted, b);
+    const bigint_array products = bigint::batch_mul(sorted, b);
+    const bigint_array remainders = bigint::batch_mod(sorted, b);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(sums[i].to_bigint(), values[i] + divisors[i]);
+        EXPECT_EQ(products[i].to_bigint(), values[i] * divisors[i]);
+        EXPECT_EQ(remainders[i].to_bigint(), values[i] % divisors[i]);
+    }
+    EXPECT_THROW(bigint::batch_mul(sorted, bigint_array()), std::invalid_argument);
+}
+
+TEST(Test_BigInt, Reduction_Tests) {
+    const std::vector<int> empty;
+    EXPECT_EQ(bigint::sum(empty.begin(), empty.end()), 0);
+    EXPECT_EQ(bigint::product(empty.begin(), empty.end()), 1);
+
+    const bigint huge{std::string{kHugeA}};
+    std::vector<bigint> values;
+    bigint expected_sum = 0, expected_product = 1;
+    for (int i = 1; i <= 5000; ++i) {
+        bigint value = i % 50 == 0 ? huge * i : bigint(999999999LL * i);
+        if (i % 3 == 0) value = -value;
+        values.push_back(value);
+        expected_sum += value;
+    }
+    for (int i = 0; i < 300; ++i) expected_product *= values[i];
+
+    EXPECT_EQ(bigint::sum(values.begin(), values.end()), expected_sum);
+    EXPECT_EQ(bigint::sum(values.begin(), values.end(), 1), expected_sum);
+    EXPECT_EQ(bigint::product(values.begin(), values.begin() + 300), expected_product);
+    EXPECT_EQ(bigint::product(values.begin(), values.begin() + 300, 1), expected_product);
+
+    // Carries and signs that cancel out, and ranges without random access
+    const std::vector<bigint> cancel{huge, -huge, bigint(999999999), bigint(1), bigint(-1000000000)};
+    EXPECT_EQ(bigint::sum(cancel.begin(), cancel.end()), 0);
+    const std::vector<bigint> borrow{-huge, bigint(1)};
+    EXPECT_EQ(bigint::sum(borrow.begin(), borrow.end()), -(huge - 1));
+    const std::list<int> small{1, -2, 3, -4, 5};
+    EXPECT_EQ(bigint::sum(small.begin(), small.end()), 3);
+    EXPECT_EQ(bigint::product(small.begin(), small.end()), 120);
+}
+
+TEST(Test_BigInt, Random_Tests) {
+    std::mt19937_64 engine(42), same(42);
+    EXPECT_EQ(bigint::random_bits(1000, engine), bigint::random_bits(1000, same));
+    EXPECT_EQ(bigint::random_digits(100, engine), bigint::random_digits(100, same));
+
+    bigint::seed_random(7);
+    const bigint first = bigint::random_digits(50);
+    bigint::seed_random(7);
+    EXPECT_EQ(bigint::random_digits(50), first);
+
+    for (std::size_t digits = 1; digits <= 40; ++digits) {
+        const bigint value = bigint::random_digits(digits, engine);
+        EXPECT_EQ(bigint::count_digits(value), static_cast<int>(digits));
+        EXPECT_FALSE(bigint::is_negative(value));
+    }
+    EXPECT_EQ(bigint::count_digits(bigint::random(1000)), 1000);
+    EXPECT_THROW(bigint::random_digits(0), std::domain_error);
+
+    EXPECT_EQ(bigint::random_bits(0, engine), 0);
+    bool top_bit_seen = false;
+    for (int i = 0; i < 50; ++i) {
+        const bigint value = bigint::random_bits(77, engine);
+        EXPECT_LT(value, bigint(1) << 77);
+        top_bit_seen = top_bit_seen || bigint::test_bit(value, 76);
+    }
+    EXPECT_TRUE(top_bit_seen);
+
+    // Every value below a small bound shows up, and nothing reaches the bound
+    std::vector<int> seen(7, 0);
+    for (int i = 0; i < 700; ++i) {
+        const bigint value = bigint::random_below(7, engine);
+        ASSERT_LT(value, 7);
+        ASSERT_GE(value, 0);
+        ++seen[static_cast<std::size_t>(bigint::to_string(value, 10)[0] - '0')];
+    }
+    for (const int count : seen) EXPECT_GT(count, 50);
+
+    // A bound just above a limb boundary, where most draws of the top limb are rejected
+    const bigint bound("1000000000000000001");
+    int high = 0;
+    for (int i = 0; i < 200; ++i) {
+        const bigint value = bigint::random_below(bound, engine);
+        ASSERT_LT(value, bound);
+        if (value >= bigint("500000000000000000")) ++high;
+    }
+    EXPECT_GT(high, 50);
+    EXPECT_LT(high, 150);
+    EXPECT_THROW(bigint::random_below(0), std::domain_error);
+
+    const bigint prime = bigint::random_prime(64);
+    EXPECT_EQ(bigint::bit_length(prime), 64u);
+    EXPECT_TRUE(bigint::is_prime(prime));
+}
+
+#if __cplusplus >= 202002L
+// Eager coroutine handing the awaited result or exception to a promise, enough to drive co_await in tests
+struct awaiting_test
+{
+    struct promise_type
+    {
+        awaiting_test get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+awaiting_test await_product(const bigint a, const bigint b, BigInt::cancellation_token token,
+                            BigInt::progress_callback progress, std::promise<bigint>& out) {
+    try {
+        out.set_value(co_await bigint::co_multiply(a, b, token, progress));
+    }
+    catch (...) {
+        out.set_exception(std::current_exception());
+    }
+}
+
+awaiting_test await_divmod(const bigint a, const bigint b, BigInt::cancellation_token token,
+                           std::promise<std::pair<bigint, bigint>>& out) {
+    try {
+        out.set_value(co_await bigint::co_divmod(a, b, token));
+    }
+    catch (...) {
+        out.set_exception(std::current_exception());
+    }
+}
+#endif
+
+TEST(Test_BigInt, Async_Tests) {
+    const bigint a = bigint::pow(7, 3000) + 1;
+    const bigint b = bigint::pow(11, 2500) - 3;
+    EXPECT_EQ(bigint::async_multiply(a, b).get(), a * b);
+    const auto qr = bigint::async_divmod(a * b + 5, b).get();
+    EXPECT_EQ(qr.first, a);
+    EXPECT_EQ(qr.second, 5);
+    EXPECT_THROW(bigint::async_divmod(a, 0).get(), std::domain_error);
+
+    // Progress never goes backwards and ends at 1
+    std::vector<double> steps;
+    EXPECT_EQ(bigint::async_pow(3, 5000, {}, [&steps](const double f) { steps.push_back(f); }).get(), bigint::pow(3, 5000));
+    ASSERT_GT(steps.size(), 2u);
+    EXPECT_TRUE(std::is_sorted(steps.begin(), steps.end()));
+    EXPECT_EQ(steps.back(), 1.0);
+
+    steps.clear();
+    EXPECT_EQ(bigint::async_factorial(3000, {}, [&steps](const double f) { steps.push_back(f); }).get(),
+              bigint::factorial(3000));
+    ASSERT_GT(steps.size(), 2u);
+    EXPECT_TRUE(std::is_sorted(steps.begin(), steps.end()));
+    EXPECT_EQ(steps.back(), 1.0);
+
+    // A token cancelled up front stops the operation before it starts
+    BigInt::cancellation_token cancelled;
+    cancelled.cancel();
+    EXPECT_TRUE(cancelled.is_cancelled());
+    EXPECT_THROW(bigint::async_multiply(a, b, cancelled).get(), BigInt::operation_cancelled);
+
+    // Cancelling from the first progress report stops at the next stage
+    BigInt::cancellation_token token;
+    std::atomic<int> reports{0};
+    const auto cancel_early = [&](double) {
+        ++reports;
+        token.cancel();
+    };
+    EXPECT_THROW(bigint::async_factorial(200000, token, cancel_early).get(), BigInt::operation_cancelled);
+    EXPECT_EQ(reports.load(), 1);
+
+    BigInt::cancellation_token division_token;
+    const auto cancel_division = [&division_token](double) { division_token.cancel(); };
+    EXPECT_THROW(bigint::async_divmod(bigint::pow(10, 20000) - 1, a, division_token, cancel_division).get(),
+                 BigInt::operation_cancelled);
+
+    // Workers are left without a context, so later operations run normally
+    EXPECT_EQ(bigint::async_factorial(25).get(), bigint::factorial(25));
+
+    // Single products, multi-limb powers and power-of-two exponents report their stages too
+    const auto intermediate = [](const std::vector<double>& reports) {
+        return std::count_if(reports.begin(), reports.end(), [](const double f) { return f > 0 && f < 1; });
+    };
+    const bigint x = bigint::pow(13, 40000), y = bigint::pow(17, 38000);
+    steps.clear();
+    EXPECT_EQ(bigint::async_multiply(x, y, {}, [&steps](const double f) { steps.push_back(f); }).get(), x * y);
+    EXPECT_GT(intermediate(steps), 10);
+    EXPECT_TRUE(std::is_sorted(steps.begin(), steps.end()));
+    EXPECT_EQ(steps.back(), 1.0);
+
+    const bigint base("123456789012345678901234567");
+    steps.clear();
+    EXPECT_EQ(bigint::async_pow(base, 1000, {}, [&steps](const double f) { steps.push_back(f); }).get(),
+              bigint::pow(base, 1000));
+    EXPECT_GT(intermediate(steps), 5);
+    EXPECT_TRUE(std::is_sorted(steps.begin(), steps.end()));
+
+    steps.clear();
+    EXPECT_EQ(bigint::async_pow(7, 1 << 12, {}, [&steps](const double f) { steps.push_back(f); }).get(),
+              bigint::pow(7, 1 << 12));
+    EXPECT_GT(intermediate(steps), 5);
+
+#if __cplusplus >= 202002L
+    std::promise<bigint> product;
+    auto product_result = product.get_future();
+    steps.clear();
+    await_product(x, y, {}, [&steps](const double f) { steps.push_back(f); }, product);
+    EXPECT_EQ(product_result.get(), x * y);
+    EXPECT_GT(intermediate(steps), 10);
+
+    std::promise<std::pair<bigint, bigint>> division;
+    auto division_result = division.get_future();
+    await_divmod(x * y + 11, y, {}, division);
+    EXPECT_EQ(division_result.get(), std::make_pair(x, bigint(11)));
+
+    std::promise<bigint> cancelled_product;
+    auto cancelled_result = cancelled_product.get_future();
+    await_product(x, y, cancelled, {}, cancelled_product);
+    EXPECT_THROW(cancelled_result.get(), BigInt::operation_cancelled);
+
+    std::promise<std::pair<bigint, bigint>> cancelled_division;
+    auto cancelled_quotient = cancelled_division.get_future();
+    await_divmod(x * y, y, cancelled, cancelled_division);
+    EXPECT_THROW(cancelled_quotient.get(), BigInt::operation_cancelled);
+#endif
+}
+
 TEST_F(Test_BigInt_Performance, Addition_Speed_Tests) {
     std::cout << "--- Starting Performance Tests (Sample size: " << number_count << ") ---" << std::endl;
     for (const size_t number_size : sizes) {
@@ -534,7 +1584,7 @@ TEST_F(Test_BigInt_Performance, Addition_Speed_Tests) {
             for (size_t i = 0; i < huge_numbers.size() - 1; ++i) {
                 answer = huge_numbers[i] + huge_numbers[i + 1];
                 // Tiny check to force evaluation
-                if (answer == 0) dce_sink++;
+                if (answer == 0) dce_sink = dce_sink + 1;
             }
         });
 
@@ -559,7 +1609,7 @@ TEST_F(Test_BigInt_Performance, Subtraction_Speed_Tests) {
             for (size_t i = 0; i < huge_numbers.size() - 1; ++i) {
                 answer = huge_numbers[i] - huge_numbers[i + 1];
                 // Tiny check to force evaluation
-                if (answer == 0) dce_sink++;
+                if (answer == 0) dce_sink = dce_sink + 1;
             }
         });
 
@@ -584,7 +1634,7 @@ TEST_F(Test_BigInt_Performance, Multiplication_Speed_Tests) {
             for (size_t i = 0; i < huge_numbers.size() - 1; ++i) {
                 answer = huge_numbers[i] * huge_numbers[i + 1];
                 // Tiny check to force evaluation
-                if (answer == 0) dce_sink++;
+                if (answer == 0) dce_sink = dce_sink + 1;
             }
         });
 
@@ -609,10 +1659,26 @@ TEST_F(Test_BigInt_Performance, Division_Speed_Tests) {
             for (size_t i = 0; i < huge_numbers.size() - 1; ++i) {
                 answer = huge_numbers[i] / 55;
                 // Tiny check to force evaluation
-                if (answer == 0) dce_sink++;
+                if (answer == 0) dce_sink = dce_sink + 1;
             }
         });
 
         std::cout << std::endl;
     }
 }
+
+TEST_F(Test_BigInt_Performance, Radix_Conversion_Scaling_Tests) {
+    // Quadratic conversion would take about 16 times as long for four times the digits
+    std::mt19937_64 engine(5);
+    double seconds[2];
+    const std::size_t digits[2] = {50000, 200000};
+    for (int i = 0; i < 2; ++i) {
+        const bigint value = bigint::random_digits(digits[i], engine);
+        const auto start = steady_clock::now();
+        const std::string text = bigint::to_string(value, 36);
+        seconds[i] = std::chrono::duration<double>(steady_clock::now() - start).count();
+        if (text.empty()) dce_sink = dce_sink + 1;
+        std::cout << "to_string base 36 [" << digits[i] << " digits]: " << seconds[i] << " s" << std::endl;
+    }
+    EXPECT_LT(seconds[1], 13 * seconds[0]);
+}